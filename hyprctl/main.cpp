@@ -15,7 +15,11 @@
 #include <fstream>
 #include <string>
 
-const std::string USAGE = R"#(usage: hyprctl [command] [(opt)args]
+const std::string USAGE = R"#(usage: hyprctl [(opt)flags] [command] [(opt)args]
+
+flags:
+    -j -> output in JSON
+    -b -> output in the binary layout
     
     monitors
     workspaces
@@ -65,25 +69,43 @@ void request(std::string arg) {
         return;
     }
 
-    auto sizeWritten = write(SERVERSOCKET, arg.c_str(), arg.length());
+    size_t totalWritten = 0;
 
-    if (sizeWritten < 0) {
-        std::cout << "Couldn't write (4)";
-        return;
+    while (totalWritten < arg.length()) {
+        const auto sizeWritten = write(SERVERSOCKET, arg.c_str() + totalWritten, arg.length() - totalWritten);
+
+        if (sizeWritten < 0) {
+            std::cout << "Couldn't write (4)";
+            return;
+        }
+
+        totalWritten += sizeWritten;
     }
 
-    char buffer[8192] = {0};
+    // the request ends where our end of the socket does
+    shutdown(SERVERSOCKET, SHUT_WR);
 
-    sizeWritten = read(SERVERSOCKET,buffer, 8192);
+    std::string reply = "";
+    char buffer[8192];
 
-    if (sizeWritten < 0) {
-        std::cout << "Couldn't read (5)";
-        return;
+    while (1) {
+        const auto sizeRead = read(SERVERSOCKET, buffer, 8192);
+
+        if (sizeRead < 0) {
+            std::cout << "Couldn't read (5)";
+            close(SERVERSOCKET);
+            return;
+        }
+
+        if (sizeRead == 0)
+            break;
+
+        reply.append(buffer, sizeRead);
     }
 
     close(SERVERSOCKET);
 
-    std::cout << std::string(buffer);
+    std::cout << reply;
 }
 
 void dispatchRequest(int argc, char** argv) {
@@ -118,18 +140,27 @@ void batchRequest(int argc, char** argv) {
 int main(int argc, char** argv) {
     int bflag = 0, sflag = 0, index, c;
 
+    // the output format flag goes in front of the query, e.g. "j/clients"
+    std::string format = "";
+
+    if (argc >= 2 && (!strcmp(argv[1], "-j") || !strcmp(argv[1], "-b"))) {
+        format = !strcmp(argv[1], "-j") ? "j/" : "b/";
+        argc--;
+        argv++;
+    }
+
     if (argc < 2) {
         printf("%s\n", USAGE.c_str());
         return 1;
     }
 
-    if (!strcmp(argv[1], "monitors")) request("monitors");
-    else if (!strcmp(argv[1], "clients")) request("clients");
-    else if (!strcmp(argv[1], "workspaces")) request("workspaces");
-    else if (!strcmp(argv[1], "activewindow")) request("activewindow");
-    else if (!strcmp(argv[1], "layers")) request("layers");
+    if (!strcmp(argv[1], "monitors")) request(format + "monitors");
+    else if (!strcmp(argv[1], "clients")) request(format + "clients");
+    else if (!strcmp(argv[1], "workspaces")) request(format + "workspaces");
+    else if (!strcmp(argv[1], "activewindow")) request(format + "activewindow");
+    else if (!strcmp(argv[1], "layers")) request(format + "layers");
     else if (!strcmp(argv[1], "version")) request("version");
-    else if (!strcmp(argv[1], "devices")) request("devices");
+    else if (!strcmp(argv[1], "devices")) request(format + "devices");
     else if (!strcmp(argv[1], "reload")) request("reload");
     else if (!strcmp(argv[1], "dispatch")) dispatchRequest(argc, argv);
     else if (!strcmp(argv[1], "keyword")) keywordRequest(argc, argv);
@@ -140,6 +171,8 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    printf("\n");
+    if (format != "b/")
+        printf("\n");
+
     return 0;
 }
@@ -1,4 +1,5 @@
 #include "Compositor.hpp"
+#include "debug/HyprCtl.hpp"
 
 CCompositor::CCompositor() {
     m_szInstanceSignature = GIT_COMMIT_HASH + std::string("_") + std::to_string(time(NULL));
@@ -113,12 +114,22 @@ CCompositor::CCompositor() {
     m_sWLRTabletManager = wlr_tablet_v2_create(m_sWLDisplay);
 }
 
+CCompositor::CCompositor(SHeadless) {
+    m_szInstanceSignature = "headless";
+
+    m_sWLROutputLayout = wlr_output_layout_create();
+
+    m_sWLRCursor = wlr_cursor_create();
+    wlr_cursor_attach_output_layout(m_sWLRCursor, m_sWLROutputLayout);
+}
+
 CCompositor::~CCompositor() {
     cleanupExit();
 }
 
 void handleCritSignal(int signo) {
     g_pCompositor->cleanupExit();
+    Debug::flush();
     exit(signo);
 }
 
@@ -160,6 +171,9 @@ void CCompositor::cleanupExit() {
     m_lWorkspaces.clear();
     m_lWindows.clear();
 
+    invalidateWorkspaceIndex();
+    invalidateWindowIndex();
+
     if (g_pXWaylandManager->m_sWLRXWayland) {
         wlr_xwayland_destroy(g_pXWaylandManager->m_sWLRXWayland);
         g_pXWaylandManager->m_sWLRXWayland = nullptr;
@@ -187,9 +201,6 @@ void CCompositor::startCompositor() {
     Debug::log(LOG, "Creating the ConfigManager!");
     g_pConfigManager = std::make_unique<CConfigManager>();
 
-    Debug::log(LOG, "Creating the ThreadManager!");
-    g_pThreadManager = std::make_unique<CThreadManager>();
-
     Debug::log(LOG, "Creating the InputManager!");
     g_pInputManager = std::make_unique<CInputManager>();
 
@@ -209,8 +220,13 @@ void CCompositor::startCompositor() {
     g_pEventManager = std::make_unique<CEventManager>();
     g_pEventManager->startThread();
 
+    HyprCtl::startHyprCtlSocket();
+
     Debug::log(LOG, "Creating the HyprDebugOverlay!");
     g_pDebugOverlay = std::make_unique<CHyprDebugOverlay>();
+
+    // everything it touches exists now
+    g_pConfigManager->init();
     //
     //
 
@@ -254,13 +270,28 @@ void CCompositor::startCompositor() {
 }
 
 SMonitor* CCompositor::getMonitorFromID(const int& id) {
-    for (auto& m : m_lMonitors) {
-        if (m.ID == (uint64_t)id) {
-            return &m;
-        }
-    }
+    if (m_bMonitorIndexDirty)
+        rebuildMonitorIndex();
 
-    return nullptr;
+    const auto IT = m_mMonitorsByID.find((uint64_t)id);
+
+    return IT == m_mMonitorsByID.end() ? nullptr : IT->second;
+}
+
+void CCompositor::invalidateMonitorIndex() {
+    m_bMonitorIndexDirty = true;
+
+    if (g_pHyprRenderer)
+        g_pHyprRenderer->invalidateRenderLists();
+}
+
+void CCompositor::rebuildMonitorIndex() {
+    m_mMonitorsByID.clear();
+
+    for (auto& m : m_lMonitors)
+        m_mMonitorsByID[m.ID] = &m;
+
+    m_bMonitorIndexDirty = false;
 }
 
 SMonitor* CCompositor::getMonitorFromName(const std::string& name) {
@@ -307,41 +338,119 @@ SMonitor* CCompositor::getMonitorFromVector(const Vector2D& point) {
 }
 
 void CCompositor::removeWindowFromVectorSafe(CWindow* pWindow) {
-    if (windowExists(pWindow) && !pWindow->m_bFadingOut)
+    if (windowExists(pWindow) && !pWindow->m_bFadingOut) {
         m_lWindows.remove(*pWindow);
+        invalidateWindowIndex();
+    }
 }
 
 bool CCompositor::windowExists(CWindow* pWindow) {
+    if (!pWindow)
+        return false;
+
+    if (m_bWindowIndexDirty)
+        rebuildWindowIndex();
+
+    return m_mWindowStackOrder.contains(pWindow);
+}
+
+void CCompositor::invalidateWindowIndex() {
+    m_bWindowIndexDirty = true;
+
+    // the render lists hold pointers into m_lWindows
+    if (g_pHyprRenderer)
+        g_pHyprRenderer->invalidateRenderLists();
+}
+
+void CCompositor::rebuildWindowIndex() {
+    for (auto& [id, windows] : m_mWorkspaceWindows)
+        windows.clear();
+
+    m_mWindowStackOrder.clear();
+    m_mSurfaceWindows.clear();
+
+    size_t order = 0;
     for (auto& w : m_lWindows) {
-        if (&w == pWindow)
-            return true;
+        m_mWorkspaceWindows[w.m_iWorkspaceID].push_back(&w);
+        m_mWindowStackOrder[&w] = order++;
+
+        if (const auto PSURFACE = g_pXWaylandManager->getWindowSurface(&w); PSURFACE)
+            m_mSurfaceWindows[PSURFACE] = &w;
     }
 
-    return false;
+    // drop buckets of workspaces that are gone, named workspaces keep getting new IDs
+    std::erase_if(m_mWorkspaceWindows, [](const auto& bucket) { return bucket.second.empty(); });
+
+    m_bWindowIndexDirty = false;
+}
+
+const std::vector<CWindow*>& CCompositor::getIndexedWindowsOnWorkspace(const int& id) {
+    static const std::vector<CWindow*> EMPTY;
+
+    if (m_bWindowIndexDirty)
+        rebuildWindowIndex();
+
+    const auto IT = m_mWorkspaceWindows.find(id);
+
+    return IT == m_mWorkspaceWindows.end() ? EMPTY : IT->second;
+}
+
+CWindow* CCompositor::floatingWindowAt(const Vector2D& pos, bool checkHidden) {
+    // floating windows can hang over onto another monitor, so every visible workspace is checked
+    // and the topmost hit wins, same as walking m_lWindows back to front.
+    CWindow* pFound = nullptr;
+    size_t foundOrder = 0;
+
+    const auto CHECKWORKSPACE = [&](const int& id) {
+        const auto& WINDOWS = getIndexedWindowsOnWorkspace(id);
+
+        for (auto it = WINDOWS.rbegin(); it != WINDOWS.rend(); ++it) {
+            const auto PWINDOW = *it;
+            wlr_box box = {PWINDOW->m_vRealPosition.vec().x, PWINDOW->m_vRealPosition.vec().y, PWINDOW->m_vRealSize.vec().x, PWINDOW->m_vRealSize.vec().y};
+            if (PWINDOW->m_bIsFloating && PWINDOW->m_bIsMapped && (!checkHidden || !PWINDOW->m_bHidden) && wlr_box_contains_point(&box, pos.x, pos.y)) {
+                const auto ORDER = m_mWindowStackOrder[PWINDOW];
+
+                if (!pFound || ORDER > foundOrder) {
+                    pFound = PWINDOW;
+                    foundOrder = ORDER;
+                }
+
+                return;
+            }
+        }
+    };
+
+    bool specialVisible = false;
+    for (auto& m : m_lMonitors) {
+        CHECKWORKSPACE(m.activeWorkspace);
+        specialVisible = specialVisible || m.specialWorkspaceOpen;
+    }
+
+    if (specialVisible)
+        CHECKWORKSPACE(SPECIAL_WORKSPACE_ID);
+
+    return pFound;
 }
 
 CWindow* CCompositor::vectorToWindow(const Vector2D& pos) {
     const auto PMONITOR = getMonitorFromVector(pos);
 
     if (PMONITOR->specialWorkspaceOpen) {
-        for (auto& w : m_lWindows) {
-            wlr_box box = {w.m_vRealPosition.vec().x, w.m_vRealPosition.vec().y, w.m_vRealSize.vec().x, w.m_vRealSize.vec().y};
-            if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID && wlr_box_contains_point(&box, pos.x, pos.y) && w.m_bIsMapped && !w.m_bIsFloating && !w.m_bHidden)
-                return &w;
+        for (auto& w : getIndexedWindowsOnWorkspace(SPECIAL_WORKSPACE_ID)) {
+            wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+            if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && !w->m_bIsFloating && !w->m_bHidden)
+                return w;
         }
     }
 
-    // first loop over floating cuz they're above, m_lWindows should be sorted bottom->top, for tiled it doesn't matter.
-    for (auto w = m_lWindows.rbegin(); w != m_lWindows.rend(); w++) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
-        if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && w->m_bIsFloating && isWorkspaceVisible(w->m_iWorkspaceID) && !w->m_bHidden)
-            return &(*w);
-    }
+    // first check floating cuz they're above, for tiled it doesn't matter.
+    if (const auto PFLOATING = floatingWindowAt(pos); PFLOATING)
+        return PFLOATING;
 
-    for (auto& w : m_lWindows) {
-        wlr_box box = {w.m_vRealPosition.vec().x, w.m_vRealPosition.vec().y, w.m_vRealSize.vec().x, w.m_vRealSize.vec().y};
-        if (wlr_box_contains_point(&box, pos.x, pos.y) && w.m_bIsMapped && !w.m_bIsFloating && PMONITOR->activeWorkspace == w.m_iWorkspaceID && !w.m_bHidden)
-            return &w;
+    for (auto& w : getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace)) {
+        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+        if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && !w->m_bIsFloating && !w->m_bHidden)
+            return w;
     }
 
     return nullptr;
@@ -351,17 +460,17 @@ CWindow* CCompositor::vectorToWindowTiled(const Vector2D& pos) {
     const auto PMONITOR = getMonitorFromVector(pos);
 
     if (PMONITOR->specialWorkspaceOpen) {
-        for (auto& w : m_lWindows) {
-            wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-            if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID && wlr_box_contains_point(&box, pos.x, pos.y) && !w.m_bIsFloating && !w.m_bHidden)
-                return &w;
+        for (auto& w : getIndexedWindowsOnWorkspace(SPECIAL_WORKSPACE_ID)) {
+            wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+            if (wlr_box_contains_point(&box, pos.x, pos.y) && !w->m_bIsFloating && !w->m_bHidden)
+                return w;
         }
     }
 
-    for (auto& w : m_lWindows) {
-        wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-        if (w.m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && w.m_iWorkspaceID == PMONITOR->activeWorkspace && !w.m_bIsFloating && !w.m_bHidden)
-            return &w;
+    for (auto& w : getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace)) {
+        wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+        if (w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->m_bIsFloating && !w->m_bHidden)
+            return w;
     }
 
     return nullptr;
@@ -372,24 +481,21 @@ CWindow* CCompositor::vectorToWindowIdeal(const Vector2D& pos) {
 
     // special workspace
     if (PMONITOR->specialWorkspaceOpen) {
-        for (auto& w : m_lWindows) {
-            wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-            if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID && w.m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w.m_bHidden)
-                return &w;
+        for (auto& w : getIndexedWindowsOnWorkspace(SPECIAL_WORKSPACE_ID)) {
+            wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+            if (w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->m_bHidden)
+                return w;
         }
     }
 
-    // first loop over floating cuz they're above, m_lWindows should be sorted bottom->top, for tiled it doesn't matter.
-    for (auto w = m_lWindows.rbegin(); w != m_lWindows.rend(); w++) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
-        if (w->m_bIsFloating && w->m_bIsMapped && wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && isWorkspaceVisible(w->m_iWorkspaceID) && !w->m_bHidden)
-            return &(*w);
-    }
+    // first check floating cuz they're above, for tiled it doesn't matter.
+    if (const auto PFLOATING = floatingWindowAt(Vector2D(m_sWLRCursor->x, m_sWLRCursor->y)); PFLOATING)
+        return PFLOATING;
 
-    for (auto& w : m_lWindows) {
-        wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-        if (!w.m_bIsFloating && w.m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && w.m_iWorkspaceID == PMONITOR->activeWorkspace && !w.m_bHidden)
-            return &w;
+    for (auto& w : getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace)) {
+        wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+        if (!w->m_bIsFloating && w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->m_bHidden)
+            return w;
     }
 
     return nullptr;
@@ -399,37 +505,28 @@ CWindow* CCompositor::windowFromCursor() {
     const auto PMONITOR = getMonitorFromCursor();
 
     if (PMONITOR->specialWorkspaceOpen) {
-        for (auto& w : m_lWindows) {
-            wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-            if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID && wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w.m_bIsMapped)
-                return &w;
+        for (auto& w : getIndexedWindowsOnWorkspace(SPECIAL_WORKSPACE_ID)) {
+            wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+            if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w->m_bIsMapped)
+                return w;
         }
     }
 
-    // first loop over floating cuz they're above, m_lWindows should be sorted bottom->top, for tiled it doesn't matter.
-    for (auto w = m_lWindows.rbegin(); w != m_lWindows.rend(); w++) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
-        if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w->m_bIsMapped && w->m_bIsFloating && isWorkspaceVisible(w->m_iWorkspaceID))
-            return &(*w);
-    }
+    // first check floating cuz they're above, for tiled it doesn't matter.
+    if (const auto PFLOATING = floatingWindowAt(Vector2D(m_sWLRCursor->x, m_sWLRCursor->y), false); PFLOATING)
+        return PFLOATING;
 
-    for (auto& w : m_lWindows) {
-        wlr_box box = {w.m_vPosition.x, w.m_vPosition.y, w.m_vSize.x, w.m_vSize.y};
-        if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w.m_bIsMapped && w.m_iWorkspaceID == PMONITOR->activeWorkspace)
-            return &w;
+    for (auto& w : getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace)) {
+        wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+        if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w->m_bIsMapped)
+            return w;
     }
 
     return nullptr;
 }
 
 CWindow* CCompositor::windowFloatingFromCursor() {
-    for (auto w = m_lWindows.rbegin(); w != m_lWindows.rend(); w++) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
-        if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y) && w->m_bIsMapped && w->m_bIsFloating && isWorkspaceVisible(w->m_iWorkspaceID) && !w->m_bHidden)
-            return &(*w);
-    }
-
-    return nullptr;
+    return floatingWindowAt(Vector2D(m_sWLRCursor->x, m_sWLRCursor->y));
 }
 
 wlr_surface* CCompositor::vectorWindowToSurface(const Vector2D& pos, CWindow* pWindow, Vector2D& sl) {
@@ -599,12 +696,18 @@ wlr_surface* CCompositor::vectorToLayerSurface(const Vector2D& pos, std::list<SL
 }
 
 CWindow* CCompositor::getWindowFromSurface(wlr_surface* pSurface) {
-    for (auto& w : m_lWindows) {
-        if (g_pXWaylandManager->getWindowSurface(&w) == pSurface)
-            return &w;
-    }
+    if (m_bWindowIndexDirty)
+        rebuildWindowIndex();
 
-    return nullptr;
+    // layers, popups and subsurfaces are asked about all the time and are never in here, a miss is a miss.
+    // Windows get (re)indexed when they map and unmap, which is when an X11 window's surface comes and goes,
+    // the check is for one that got dissociated since.
+    const auto IT = m_mSurfaceWindows.find(pSurface);
+
+    if (IT == m_mSurfaceWindows.end() || g_pXWaylandManager->getWindowSurface(IT->second) != pSurface)
+        return nullptr;
+
+    return IT->second;
 }
 
 CWindow* CCompositor::getFullscreenWindowOnWorkspace(const int& ID) {
@@ -629,18 +732,40 @@ bool CCompositor::isWorkspaceVisible(const int& w) {
 }
 
 CWorkspace* CCompositor::getWorkspaceByID(const int& id) {
+    if (m_bWorkspaceIndexDirty)
+        rebuildWorkspaceIndex();
+
+    const auto IT = m_mWorkspacesByID.find(id);
+
+    return IT == m_mWorkspacesByID.end() ? nullptr : IT->second;
+}
+
+void CCompositor::invalidateWorkspaceIndex() {
+    m_bWorkspaceIndexDirty = true;
+
+    // workspaces coming, going or moving monitors change what the monitors show
+    if (g_pHyprRenderer)
+        g_pHyprRenderer->invalidateRenderLists();
+}
+
+void CCompositor::rebuildWorkspaceIndex() {
+    m_mWorkspacesByID.clear();
+    m_mWorkspacesByName.clear();
+
+    // keep the first one on duplicate IDs / names, like the old front-to-back scan did
     for (auto& w : m_lWorkspaces) {
-        if (w.m_iID == id)
-            return &w;
+        m_mWorkspacesByID.emplace(w.m_iID, &w);
+        m_mWorkspacesByName.emplace(w.m_szName, &w);
     }
 
-    return nullptr;
+    m_bWorkspaceIndexDirty = false;
 }
 
 void CCompositor::sanityCheckWorkspaces() {
     for (auto it = m_lWorkspaces.begin(); it != m_lWorkspaces.end(); ++it) {
         if ((getWindowsOnWorkspace(it->m_iID) == 0 && !isWorkspaceVisible(it->m_iID))) {
             it = m_lWorkspaces.erase(it);
+            invalidateWorkspaceIndex();
         }
 
         if (it->m_iID == SPECIAL_WORKSPACE_ID && getWindowsOnWorkspace(it->m_iID) == 0) {
@@ -649,14 +774,15 @@ void CCompositor::sanityCheckWorkspaces() {
             }
 
             it = m_lWorkspaces.erase(it);
+            invalidateWorkspaceIndex();
         }
     }
 }
 
 int CCompositor::getWindowsOnWorkspace(const int& id) {
     int no = 0;
-    for (auto& w : m_lWindows) {
-        if (w.m_iWorkspaceID == id && w.m_bIsMapped)
+    for (auto& w : getIndexedWindowsOnWorkspace(id)) {
+        if (w->m_bIsMapped)
             no++;
     }
 
@@ -717,6 +843,7 @@ void CCompositor::moveWindowToTop(CWindow* pWindow) {
     for (auto it = m_lWindows.begin(); it != m_lWindows.end(); ++it) {
         if (&(*it) == pWindow) {
             m_lWindows.splice(m_lWindows.end(), m_lWindows, it);
+            invalidateWindowIndex();
             break;
         }
     }
@@ -735,6 +862,7 @@ void CCompositor::cleanupFadingOut() {
             g_pHyprOpenGL->m_mWindowFramebuffers.erase(w);
             m_lWindows.remove(*w);
             m_lWindowsFadingOut.remove(w);
+            invalidateWindowIndex();
 
             Debug::log(LOG, "Cleanup: destroyed a window");
             return;
@@ -864,12 +992,12 @@ int CCompositor::getNextAvailableNamedWorkspace() {
 }
 
 CWorkspace* CCompositor::getWorkspaceByName(const std::string& name) {
-    for (auto& w : m_lWorkspaces) {
-        if (w.m_szName == name)
-            return &w;
-    }
+    if (m_bWorkspaceIndexDirty)
+        rebuildWorkspaceIndex();
 
-    return nullptr;
+    const auto IT = m_mWorkspacesByName.find(name);
+
+    return IT == m_mWorkspacesByName.end() ? nullptr : IT->second;
 }
 
 CWorkspace* CCompositor::getWorkspaceByString(const std::string& str) {
@@ -985,6 +1113,11 @@ void CCompositor::updateAllWindowsBorders() {
 }
 
 void CCompositor::updateWindowBorderColor(CWindow* pWindow) {
+    if (m_iBatchDepth > 0) {
+        m_sBatchedBorderUpdates.insert(pWindow);
+        return;
+    }
+
     // optimization
     static int64_t* ACTIVECOL = &g_pConfigManager->getConfigValuePtr("general:col.active_border")->intValue;
     static int64_t* INACTIVECOL = &g_pConfigManager->getConfigValuePtr("general:col.inactive_border")->intValue;
@@ -1026,6 +1159,8 @@ void CCompositor::moveWorkspaceToMonitor(CWorkspace* pWorkspace, SMonitor* pMoni
 
     const bool SWITCHINGISACTIVE = POLDMON->activeWorkspace == pWorkspace->m_iID;
 
+    g_pHyprRenderer->invalidateRenderLists();
+
     // fix old mon
     int nextWorkspaceOnMonitorID = -1;
     for (auto& w : m_lWorkspaces) {
@@ -1092,4 +1227,33 @@ bool CCompositor::workspaceIDOutOfBounds(const int& id) {
     }
 
     return std::clamp(id, lowestID, highestID) != id;
-}
\ No newline at end of file
+}
+
+void CCompositor::beginBatch() {
+    m_iBatchDepth++;
+}
+
+bool CCompositor::isBatching() {
+    return m_iBatchDepth > 0;
+}
+
+void CCompositor::endBatch() {
+    RASSERT(m_iBatchDepth > 0, "endBatch without a beginBatch!");
+
+    if (--m_iBatchDepth > 0)
+        return;
+
+    // order matters: the layout moves windows, which changes borders, which come before the events.
+    // damage is collected until the next frame anyways.
+    g_pLayoutManager->getCurrentLayout()->onBatchEnd();
+
+    const auto BORDERS = std::move(m_sBatchedBorderUpdates);
+    m_sBatchedBorderUpdates.clear();
+
+    for (auto& w : BORDERS) {
+        if (windowValidMapped(w))
+            updateWindowBorderColor(w);
+    }
+
+    g_pEventManager->flushBatchedEvents();
+}
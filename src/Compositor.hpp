@@ -3,12 +3,14 @@
 #include <memory>
 #include <deque>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "defines.hpp"
 #include "debug/Log.hpp"
 #include "events/Events.hpp"
 #include "config/ConfigManager.hpp"
-#include "managers/ThreadManager.hpp"
 #include "managers/XWaylandManager.hpp"
 #include "managers/input/InputManager.hpp"
 #include "managers/LayoutManager.hpp"
@@ -28,42 +30,47 @@ public:
     CCompositor();
     ~CCompositor();
 
+    // no display, backend or renderer, only an output layout and a cursor. Windows, workspaces and monitors
+    // can be put into the lists by hand, for tests and benchmarks of everything that works on them.
+    struct SHeadless {};
+    explicit CCompositor(SHeadless);
+
     // ------------------ WLR BASICS ------------------ //
-    wl_display*                      m_sWLDisplay;
-    wlr_backend*                     m_sWLRBackend;
-    wlr_renderer*                    m_sWLRRenderer;
-    wlr_allocator*                   m_sWLRAllocator;
-    wlr_compositor*                  m_sWLRCompositor;
-    wlr_subcompositor*               m_sWLRSubCompositor;
-    wlr_data_device_manager*         m_sWLRDataDevMgr;
-    wlr_xdg_activation_v1*           m_sWLRXDGActivation;
-    wlr_output_layout*               m_sWLROutputLayout;
-    wlr_idle*                        m_sWLRIdle;
-    wlr_layer_shell_v1*              m_sWLRLayerShell;
-    wlr_xdg_shell*                   m_sWLRXDGShell;
-    wlr_cursor*                      m_sWLRCursor;
-    wlr_xcursor_manager*             m_sWLRXCursorMgr;
-    wlr_virtual_keyboard_manager_v1* m_sWLRVKeyboardMgr;
-    wlr_output_manager_v1*           m_sWLROutputMgr;
-    wlr_presentation*                m_sWLRPresentation;
-    wlr_scene*                       m_sWLRScene;
-    wlr_input_inhibit_manager*       m_sWLRInhibitMgr;
-    wlr_keyboard_shortcuts_inhibit_manager_v1* m_sWLRKbShInhibitMgr;
-    wlr_egl*                         m_sWLREGL;
-    int                              m_iDRMFD;
-    wlr_ext_workspace_manager_v1*    m_sWLREXTWorkspaceMgr;
-    wlr_linux_dmabuf_v1*             m_sWLRDmabuf;
-    wlr_pointer_constraints_v1*      m_sWLRPointerConstraints;
-    wlr_relative_pointer_manager_v1* m_sWLRRelPointerMgr;
-    wlr_server_decoration_manager*   m_sWLRServerDecoMgr;
-    wlr_xdg_decoration_manager_v1*   m_sWLRXDGDecoMgr;
-    wlr_virtual_pointer_manager_v1*  m_sWLRVirtPtrMgr;
-    wlr_foreign_toplevel_manager_v1* m_sWLRToplevelMgr;
-    wlr_tablet_manager_v2*           m_sWLRTabletManager;
+    wl_display*                      m_sWLDisplay = nullptr;
+    wlr_backend*                     m_sWLRBackend = nullptr;
+    wlr_renderer*                    m_sWLRRenderer = nullptr;
+    wlr_allocator*                   m_sWLRAllocator = nullptr;
+    wlr_compositor*                  m_sWLRCompositor = nullptr;
+    wlr_subcompositor*               m_sWLRSubCompositor = nullptr;
+    wlr_data_device_manager*         m_sWLRDataDevMgr = nullptr;
+    wlr_xdg_activation_v1*           m_sWLRXDGActivation = nullptr;
+    wlr_output_layout*               m_sWLROutputLayout = nullptr;
+    wlr_idle*                        m_sWLRIdle = nullptr;
+    wlr_layer_shell_v1*              m_sWLRLayerShell = nullptr;
+    wlr_xdg_shell*                   m_sWLRXDGShell = nullptr;
+    wlr_cursor*                      m_sWLRCursor = nullptr;
+    wlr_xcursor_manager*             m_sWLRXCursorMgr = nullptr;
+    wlr_virtual_keyboard_manager_v1* m_sWLRVKeyboardMgr = nullptr;
+    wlr_output_manager_v1*           m_sWLROutputMgr = nullptr;
+    wlr_presentation*                m_sWLRPresentation = nullptr;
+    wlr_scene*                       m_sWLRScene = nullptr;
+    wlr_input_inhibit_manager*       m_sWLRInhibitMgr = nullptr;
+    wlr_keyboard_shortcuts_inhibit_manager_v1* m_sWLRKbShInhibitMgr = nullptr;
+    wlr_egl*                         m_sWLREGL = nullptr;
+    int                              m_iDRMFD = -1;
+    wlr_ext_workspace_manager_v1*    m_sWLREXTWorkspaceMgr = nullptr;
+    wlr_linux_dmabuf_v1*             m_sWLRDmabuf = nullptr;
+    wlr_pointer_constraints_v1*      m_sWLRPointerConstraints = nullptr;
+    wlr_relative_pointer_manager_v1* m_sWLRRelPointerMgr = nullptr;
+    wlr_server_decoration_manager*   m_sWLRServerDecoMgr = nullptr;
+    wlr_xdg_decoration_manager_v1*   m_sWLRXDGDecoMgr = nullptr;
+    wlr_virtual_pointer_manager_v1*  m_sWLRVirtPtrMgr = nullptr;
+    wlr_foreign_toplevel_manager_v1* m_sWLRToplevelMgr = nullptr;
+    wlr_tablet_manager_v2*           m_sWLRTabletManager = nullptr;
     // ------------------------------------------------- //
 
 
-    const char*             m_szWLDisplaySocket;
+    const char*             m_szWLDisplaySocket = nullptr;
     std::string             m_szInstanceSignature = "";
 
     std::list<SMonitor>     m_lMonitors;
@@ -132,9 +139,41 @@ public:
     int                     getNextAvailableMonitorID();
     void                    moveWorkspaceToMonitor(CWorkspace*, SMonitor*);
     bool                    workspaceIDOutOfBounds(const int&);
+    void                    invalidateWindowIndex();
+    void                    invalidateWorkspaceIndex();
+    void                    invalidateMonitorIndex();
+    const std::vector<CWindow*>& getIndexedWindowsOnWorkspace(const int&);
+
+    // [[BATCH]] transactions. While batching, relayouts, border updates, damage and socket2 events
+    // are only collected, and endBatch() applies them once. Nests.
+    void                    beginBatch();
+    void                    endBatch();
+    bool                    isBatching();
 
 private:
     void                    initAllSignals();
+    void                    rebuildWindowIndex();
+    void                    rebuildWorkspaceIndex();
+    void                    rebuildMonitorIndex();
+    CWindow*                floatingWindowAt(const Vector2D&, bool checkHidden = true);
+
+    // per-workspace buckets of m_lWindows, kept in stacking order (bottom->top)
+    // rebuilt lazily on the first hit-test after a window is added, removed, restacked or moved to another workspace
+    std::unordered_map<int, std::vector<CWindow*>> m_mWorkspaceWindows;
+    // also the registry of live windows, a pointer not in here is not a window (anymore)
+    std::unordered_map<CWindow*, size_t>           m_mWindowStackOrder;
+    std::unordered_map<wlr_surface*, CWindow*>     m_mSurfaceWindows;
+    bool                    m_bWindowIndexDirty = true;
+
+    std::unordered_map<int, CWorkspace*>           m_mWorkspacesByID;
+    std::unordered_map<std::string, CWorkspace*>   m_mWorkspacesByName;
+    bool                    m_bWorkspaceIndexDirty = true;
+
+    std::unordered_map<uint64_t, SMonitor*>        m_mMonitorsByID;
+    bool                    m_bMonitorIndexDirty = true;
+
+    int                     m_iBatchDepth = 0;
+    std::unordered_set<CWindow*>                   m_sBatchedBorderUpdates;
 };
 
 
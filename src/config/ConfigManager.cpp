@@ -1,7 +1,10 @@
 #include "ConfigManager.hpp"
 #include "../managers/KeybindManager.hpp"
 
+#include <limits.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -42,6 +45,7 @@ void CConfigManager::setDefaultVars() {
     configValues["decoration:blur_size"].intValue = 8;
     configValues["decoration:blur_passes"].intValue = 1;
     configValues["decoration:blur_ignore_opacity"].intValue = 0;
+    configValues["decoration:blur_new_optimizations"].intValue = 0;
     configValues["decoration:active_opacity"].floatValue = 1;
     configValues["decoration:inactive_opacity"].floatValue = 1;
     configValues["decoration:fullscreen_opacity"].floatValue = 1;
@@ -95,23 +99,104 @@ void CConfigManager::setDefaultVars() {
     configValues["autogenerated"].intValue = 0;
 }
 
+int onConfigWatchEvent(int fd, uint32_t mask, void* data) {
+    const auto PCONFIGMANAGER = (CConfigManager*)data;
+
+    alignas(inotify_event) char buffer[4096];
+    bool reload = false;
+
+    while (1) {
+        const auto LEN = read(fd, buffer, sizeof(buffer));
+
+        if (LEN <= 0)
+            break;
+
+        for (char* p = buffer; p < buffer + LEN;) {
+            const auto EV = (inotify_event*)p;
+            p += sizeof(inotify_event) + EV->len;
+
+            const auto DIR = PCONFIGMANAGER->m_mWatchedDirs.find(EV->wd);
+
+            if (DIR == PCONFIGMANAGER->m_mWatchedDirs.end() || EV->len == 0)
+                continue;
+
+            // we watch the dirs, so that editors replacing the file don't lose us
+            const auto PATH = DIR->second + EV->name;
+
+            if (std::find(PCONFIGMANAGER->m_vWatchedPaths.begin(), PCONFIGMANAGER->m_vWatchedPaths.end(), PATH) != PCONFIGMANAGER->m_vWatchedPaths.end())
+                reload = true;
+        }
+    }
+
+    if (reload)
+        PCONFIGMANAGER->reload();
+
+    return 0;
+}
+
 void CConfigManager::init() {
     
     loadConfigLoadVars();
 
-    const char* const ENVHOME = getenv("HOME");
+    m_iInotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
 
-    const std::string CONFIGPATH = ENVHOME + (ISDEBUG ? (std::string) "/.config/hypr/hyprlandd.conf" : (std::string) "/.config/hypr/hyprland.conf");
+    if (m_iInotifyFD < 0) {
+        Debug::log(ERR, "Couldn't init inotify, the config will not be reloaded automatically. (errno %d)", errno);
+    } else {
+        wl_event_loop_add_fd(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), m_iInotifyFD, WL_EVENT_READABLE, onConfigWatchEvent, this);
+        updateWatches();
+    }
+
+    isFirstLaunch = false;
+}
+
+void CConfigManager::updateWatches() {
+    if (m_iInotifyFD < 0)
+        return;
 
-    struct stat fileStat;
-    int err = stat(CONFIGPATH.c_str(), &fileStat);
-    if (err != 0) {
-        Debug::log(WARN, "Error at statting config, error %i", errno);
+    std::unordered_map<std::string, int> dirs;
+    for (auto& [wd, dir] : m_mWatchedDirs)
+        dirs[dir] = wd;
+
+    // a symlinked config (dotfile managers) gets edited where it points, watch both ends
+    m_vWatchedPaths.clear();
+    for (auto& path : configPaths) {
+        m_vWatchedPaths.push_back(path);
+
+        char resolved[PATH_MAX];
+        if (realpath(path.c_str(), resolved) && path != resolved)
+            m_vWatchedPaths.push_back(resolved);
     }
 
-    configModifyTimes[CONFIGPATH] = fileStat.st_mtime;
+    // sourced files can come and go, watch the dirs of what we have now
+    std::unordered_map<int, std::string> newWatches;
+    for (auto& path : m_vWatchedPaths) {
+        const auto DIR = path.substr(0, path.find_last_of('/') + 1);
 
-    isFirstLaunch = false;
+        if (DIR.empty() || std::find_if(newWatches.begin(), newWatches.end(), [&](const auto& other) { return other.second == DIR; }) != newWatches.end())
+            continue;
+
+        if (dirs.contains(DIR)) {
+            newWatches[dirs[DIR]] = DIR;
+            dirs.erase(DIR);
+            continue;
+        }
+
+        const auto WD = inotify_add_watch(m_iInotifyFD, DIR.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+        if (WD < 0) {
+            Debug::log(WARN, "Couldn't watch %s for config changes (errno %d)", DIR.c_str(), errno);
+            continue;
+        }
+
+        newWatches[WD] = DIR;
+    }
+
+    // whatever's left isn't needed anymore
+    for (auto& [dir, wd] : dirs)
+        inotify_rm_watch(m_iInotifyFD, wd);
+
+    m_mWatchedDirs = newWatches;
 }
 
 void CConfigManager::configSetValueSafe(const std::string& COMMAND, const std::string& VALUE) {
@@ -361,6 +446,8 @@ void CConfigManager::handleBezier(const std::string& command, const std::string&
     float p2y = std::stof(curitem);
 
     g_pAnimationManager->addBezierWithName(bezierName, Vector2D(p1x, p1y), Vector2D(p2x, p2y));
+
+    Debug::log(LOG, "Config: bezier %s with %.2f, %.2f, %.2f, %.2f", bezierName.c_str(), p1x, p1y, p2x, p2y);
 }
 
 void CConfigManager::handleAnimation(const std::string& command, const std::string& args) {
@@ -488,7 +575,23 @@ void CConfigManager::handleWindowRule(const std::string& command, const std::str
             return;
         }
 
-    m_dWindowRules.push_back({RULE, VALUE});
+    SWindowRule rule = {RULE, VALUE};
+
+    // no regex syntax -> a substring search does the same job
+    rule.bLiteral = VALUE.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+
+    if (!rule.bLiteral) {
+        try {
+            rule.rRegex = std::make_shared<std::regex>(VALUE, std::regex::optimize);
+        } catch (std::exception& e) {
+            Debug::log(ERR, "Invalid regex in window rule %s: %s", VALUE.c_str(), e.what());
+            parseError = "Invalid regex in windowrule: " + VALUE;
+            return;
+        }
+    }
+
+    m_dWindowRules.push_back(rule);
+    m_mWindowRuleCache.clear();
 
 }
 
@@ -522,15 +625,6 @@ void CConfigManager::handleSource(const std::string& command, const std::string&
 
     configPaths.push_back(value);
 
-    struct stat fileStat;
-    int err = stat(value.c_str(), &fileStat);
-    if (err != 0) {
-        Debug::log(WARN, "Error at ticking config at %s, error %i: %s", value.c_str(), err, strerror(err));
-        return;
-    }
-
-    configModifyTimes[value] = fileStat.st_mtime;
-
     std::ifstream ifs;
     ifs.open(value);
     std::string line = "";
@@ -672,15 +766,61 @@ void CConfigManager::parseLine(std::string& line) {
     parseKeyword(COMMAND, VALUE);
 }
 
+uint32_t CConfigManager::subsystemsForValue(const std::string& name) {
+    if (name.find("general:") == 0)
+        return CONFIG_SUBSYSTEM_LAYOUT | CONFIG_SUBSYSTEM_BORDERS;
+    if (name.find("dwindle:") == 0)
+        return CONFIG_SUBSYSTEM_LAYOUT;
+    if (name.find("decoration:") == 0)
+        return CONFIG_SUBSYSTEM_BLUR;
+    if (name.find("input:") == 0)
+        return CONFIG_SUBSYSTEM_KEYBOARD;
+
+    // animations, misc, debug: read when used, nothing to poke
+    return 0;
+}
+
+std::string CConfigManager::subsystemsToString(uint32_t subsystems) {
+    std::string result = "";
+
+    const std::pair<eConfigSubsystem, const char*> NAMES[] = {{CONFIG_SUBSYSTEM_LAYOUT, "layout"},     {CONFIG_SUBSYSTEM_BORDERS, "borders"}, {CONFIG_SUBSYSTEM_KEYBOARD, "keyboard"},
+                                                              {CONFIG_SUBSYSTEM_MONITORS, "monitors"}, {CONFIG_SUBSYSTEM_BLUR, "blur"}};
+
+    for (auto& [bit, name] : NAMES) {
+        if (!(subsystems & bit))
+            continue;
+
+        if (!result.empty())
+            result += " ";
+
+        result += name;
+    }
+
+    return result.empty() ? "none" : result;
+}
+
+void CConfigManager::reload() {
+    loadConfigLoadVars();
+    updateWatches();
+}
+
 void CConfigManager::loadConfigLoadVars() {
     Debug::log(LOG, "Reloading the config!");
     parseError = "";       // reset the error
     currentCategory = "";  // reset the category
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+
+    // what we had, to see what actually changed
+    const auto PREVVALUES = configValues;
+    const auto PREVMONITORRULES = m_dMonitorRules;
+    const auto PREVRESERVEDAREAS = m_mAdditionalReservedAreas;
     
     // reset all vars before loading
     setDefaultVars();
     m_dMonitorRules.clear();
     m_dWindowRules.clear();
+    m_mWindowRuleCache.clear();
     g_pKeybindManager->clearKeybinds();
     g_pAnimationManager->removeAllBeziers();
     m_mAdditionalReservedAreas.clear();
@@ -753,13 +893,6 @@ void CConfigManager::loadConfigLoadVars() {
         ifs.close();
     }
 
-    for (auto& m : g_pCompositor->m_lMonitors)
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m.ID);
-
-    // Update the keyboard layout to the cfg'd one if this is not the first launch
-    if (!isFirstLaunch)
-        g_pInputManager->setKeyboardLayout();
-
     // Calculate the internal vars
     configValues["general:main_mod_internal"].intValue = g_pKeybindManager->stringToModMask(configValues["general:main_mod"].strValue);
     const auto DAMAGETRACKINGMODE = g_pHyprRenderer->damageTrackingModeFromStr(configValues["general:damage_tracking"].strValue);
@@ -778,58 +911,70 @@ void CConfigManager::loadConfigLoadVars() {
     else
         g_pHyprError->destroy();
 
+    // diff against what we had, and only touch what changed
+    uint32_t changed = 0;
+
+    for (auto& [name, value] : configValues) {
+        const auto PREV = PREVVALUES.find(name);
+
+        if (PREV == PREVVALUES.end() || !(PREV->second == value))
+            changed |= subsystemsForValue(name);
+    }
+
+    if (!(PREVMONITORRULES == m_dMonitorRules))
+        changed |= CONFIG_SUBSYSTEM_MONITORS;
+
+    if (!(PREVRESERVEDAREAS == m_mAdditionalReservedAreas))
+        changed |= CONFIG_SUBSYSTEM_LAYOUT;
+
+    if (changed & CONFIG_SUBSYSTEM_LAYOUT) {
+        for (auto& m : g_pCompositor->m_lMonitors)
+            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m.ID);
+    }
+
+    // Update the keyboard layout to the cfg'd one if this is not the first launch
+    if (!isFirstLaunch && changed & CONFIG_SUBSYSTEM_KEYBOARD)
+        g_pInputManager->setKeyboardLayout();
+
     // Set the modes for all monitors as we configured them
     // not on first launch because monitors might not exist yet
     // and they'll be taken care of in the newMonitor event
-    if (!isFirstLaunch) {
+    if (!isFirstLaunch && changed & CONFIG_SUBSYSTEM_MONITORS) {
         m_bWantsMonitorReload = true;
     }
 
     // Update window border colors
-    g_pCompositor->updateAllWindowsBorders();
-}
-
-void CConfigManager::tick() {
-    static const char* const ENVHOME = getenv("HOME");
-
-    const std::string CONFIGPATH = ENVHOME + (ISDEBUG ? (std::string) "/.config/hypr/hyprlandd.conf" : (std::string) "/.config/hypr/hyprland.conf");
+    if (changed & CONFIG_SUBSYSTEM_BORDERS)
+        g_pCompositor->updateAllWindowsBorders();
 
-    if (!std::filesystem::exists(CONFIGPATH)) {
-        Debug::log(ERR, "Config doesn't exist??");
-        return;
+    // blur settings might have changed
+    if (changed & CONFIG_SUBSYSTEM_BLUR) {
+        for (auto& m : g_pCompositor->m_lMonitors)
+            g_pHyprOpenGL->markBlurDirtyForMonitor(&m);
     }
 
-    bool parse = false;
+    const float ELAPSEDMS = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - BEGIN).count();
+    const auto SUBSYSTEMS = subsystemsToString(changed);
 
-    for (auto& cf : configPaths) {
-        struct stat fileStat;
-        int err = stat(cf.c_str(), &fileStat);
-        if (err != 0) {
-            Debug::log(WARN, "Error at ticking config at %s, error %i: %s", cf.c_str(), err, strerror(err));
-            return;
-        }
-
-        // check if we need to reload cfg
-        if (fileStat.st_mtime != configModifyTimes[cf] || m_bForceReload) {
-            parse = true;
-            configModifyTimes[cf] = fileStat.st_mtime;
-        }
-    }
+    Debug::log(LOG, "Config reloaded in %.2fms, touched: %s", ELAPSEDMS, SUBSYSTEMS.c_str());
 
-    if (parse) {
-        m_bForceReload = false;
-
-        loadConfigLoadVars();
-    }
+    if (!isFirstLaunch)
+        g_pEventManager->postEvent(SHyprIPCEvent("configreloaded", getFormat("%.2f,%s", ELAPSEDMS, SUBSYSTEMS.c_str())));
 }
 
-std::mutex configmtx;
-SConfigValue CConfigManager::getConfigValueSafe(std::string val) {
-    std::lock_guard<std::mutex> lg(configmtx);
+// everything config lives on the main thread, reloads included, so no locking and no copies.
+// Anything hot should cache getConfigValuePtr() in a static instead of going through here.
+const SConfigValue& CConfigManager::getConfigValueSafe(const std::string& val) {
+    const auto IT = configValues.find(val);
 
-    SConfigValue copy = configValues[val];
+    if (IT == configValues.end()) {
+        // don't insert it, a typo would otherwise stay around as a value nobody sets
+        static const SConfigValue EMPTY;
+        Debug::log(WARN, "getConfigValueSafe: %s is not a config value, did you make a typo?", val.c_str());
+        return EMPTY;
+    }
 
-    return copy;
+    return IT->second;
 }
 
 int CConfigManager::getInt(std::string v) {
@@ -891,6 +1036,36 @@ SMonitorRule CConfigManager::getMonitorRuleFor(std::string name) {
     return SMonitorRule{.name = "", .resolution = Vector2D(1280, 720), .offset = Vector2D(0, 0), .scale = 1};
 }
 
+const std::vector<size_t>& CConfigManager::getMatchingRuleIndices(const std::string& title, const std::string& appidclass) {
+    // the same class and title always match the same rules
+    const auto CACHEKEY = appidclass + '\n' + title;
+    auto CACHED = m_mWindowRuleCache.find(CACHEKEY);
+
+    if (CACHED != m_mWindowRuleCache.end())
+        return CACHED->second;
+
+    std::vector<size_t> matched;
+
+    for (size_t i = 0; i < m_dWindowRules.size(); ++i) {
+        const auto& RULE = m_dWindowRules[i];
+
+        // check if we have a matching rule
+        if (RULE.bLiteral) {
+            if (title.find(RULE.szValue) == std::string::npos && appidclass.find(RULE.szValue) == std::string::npos)
+                continue;
+        } else if (!std::regex_search(title, *RULE.rRegex) && !std::regex_search(appidclass, *RULE.rRegex))
+            continue;
+
+        matched.push_back(i);
+    }
+
+    // titles can change a lot (terminals, browsers), don't let this grow forever
+    if (m_mWindowRuleCache.size() > 1024)
+        m_mWindowRuleCache.clear();
+
+    return m_mWindowRuleCache.emplace(CACHEKEY, std::move(matched)).first->second;
+}
+
 std::vector<SWindowRule> CConfigManager::getMatchingRules(CWindow* pWindow) {
     if (!g_pCompositor->windowValidMapped(pWindow))
         return std::vector<SWindowRule>();
@@ -900,21 +1075,13 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(CWindow* pWindow) {
     std::string title = g_pXWaylandManager->getTitle(pWindow);
     std::string appidclass = g_pXWaylandManager->getAppIDClass(pWindow);
 
-    for (auto& rule : m_dWindowRules) {
-        // check if we have a matching rule
-        try {
-            std::regex classCheck(rule.szValue);
-
-            if (!std::regex_search(title, classCheck) && !std::regex_search(appidclass, classCheck))
-                continue;
-        } catch (...) {
-            Debug::log(ERR, "Regex error at %s", rule.szValue.c_str());
-        }
+    for (auto& i : getMatchingRuleIndices(title, appidclass)) {
+        const auto& RULE = m_dWindowRules[i];
 
         // applies. Read the rule and behave accordingly
-        Debug::log(LOG, "Window rule %s -> %s matched %x [%s]", rule.szRule.c_str(), rule.szValue.c_str(), pWindow, pWindow->m_szTitle.c_str());
+        Debug::log(LOG, "Window rule %s -> %s matched %x [%s]", RULE.szRule.c_str(), RULE.szValue.c_str(), pWindow, pWindow->m_szTitle.c_str());
 
-        returns.push_back(rule);
+        returns.push_back(RULE);
     }
 
     return returns;
@@ -943,5 +1110,13 @@ void CConfigManager::performMonitorReload() {
 }
 
 SConfigValue* CConfigManager::getConfigValuePtr(std::string val) {
-    return &configValues[val];
+    // the map is node based and values are only ever reassigned, so the pointer stays valid for good
+    const auto IT = configValues.find(val);
+
+    if (IT == configValues.end()) {
+        Debug::log(WARN, "getConfigValuePtr: %s is not a config value, did you make a typo?", val.c_str());
+        return &configValues[val];
+    }
+
+    return &IT->second;
 }
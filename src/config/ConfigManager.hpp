@@ -20,6 +20,10 @@ struct SConfigValue {
     int64_t intValue = -1;
     float floatValue = -1;
     std::string strValue = "";
+
+    bool operator==(const SConfigValue& rhs) const {
+        return intValue == rhs.intValue && floatValue == rhs.floatValue && strValue == rhs.strValue;
+    }
 };
 
 struct SMonitorRule {
@@ -31,6 +35,10 @@ struct SMonitorRule {
     int         defaultWorkspaceID = -1;
     bool        disabled = false;
     wl_output_transform transform = WL_OUTPUT_TRANSFORM_NORMAL;
+
+    bool operator==(const SMonitorRule& rhs) const {
+        return name == rhs.name && resolution == rhs.resolution && offset == rhs.offset && scale == rhs.scale && refreshRate == rhs.refreshRate && defaultWorkspaceID == rhs.defaultWorkspaceID && disabled == rhs.disabled && transform == rhs.transform;
+    }
 };
 
 struct SMonitorAdditionalReservedArea {
@@ -38,20 +46,40 @@ struct SMonitorAdditionalReservedArea {
     int         bottom = 0;
     int         left = 0;
     int         right = 0;
+
+    bool operator==(const SMonitorAdditionalReservedArea& rhs) const {
+        return top == rhs.top && bottom == rhs.bottom && left == rhs.left && right == rhs.right;
+    }
 };
 
 struct SWindowRule {
     std::string szRule;
     std::string szValue;
+
+    // compiled once when the rule is added. Plain strings skip the regex and use find()
+    std::shared_ptr<std::regex> rRegex;
+    bool        bLiteral = false;
+};
+
+// what a config reload has to poke after parsing
+enum eConfigSubsystem {
+    CONFIG_SUBSYSTEM_LAYOUT = 1 << 0,
+    CONFIG_SUBSYSTEM_BORDERS = 1 << 1,
+    CONFIG_SUBSYSTEM_KEYBOARD = 1 << 2,
+    CONFIG_SUBSYSTEM_MONITORS = 1 << 3,
+    CONFIG_SUBSYSTEM_BLUR = 1 << 4,
 };
 
 class CConfigManager {
 public:
     CConfigManager();
 
-    void                tick();
+    // loads the config and starts watching it, on the main thread
     void                init();
 
+    // reparses the config and applies whatever changed
+    void                reload();
+
     int                 getInt(std::string);
     float               getFloat(std::string);
     std::string         getString(std::string);
@@ -64,6 +92,8 @@ public:
     SMonitorRule        getMonitorRuleFor(std::string);
 
     std::vector<SWindowRule> getMatchingRules(CWindow*);
+    // the matching itself, indices into the window rules. Cached per class + title.
+    const std::vector<size_t>& getMatchingRuleIndices(const std::string& title, const std::string& appidclass);
 
     std::unordered_map<std::string, SMonitorAdditionalReservedArea> m_mAdditionalReservedAreas;
 
@@ -72,18 +102,23 @@ public:
 
     void                performMonitorReload();
     bool                m_bWantsMonitorReload = false;
-    bool                m_bForceReload = false;
 
     std::string         parseKeyword(const std::string&, const std::string&, bool dynamic = false);
 
+    // for the inotify event source
+    friend int          onConfigWatchEvent(int, uint32_t, void*);
+
 private:
     std::deque<std::string>                       configPaths; // stores all the config paths
-    std::unordered_map<std::string, time_t>       configModifyTimes; // stores modify times
     std::unordered_map<std::string, std::string>  configDynamicVars; // stores dynamic vars declared by the user
     std::unordered_map<std::string, SConfigValue> configValues;
 
     std::string                                   configCurrentPath;
 
+    int                                           m_iInotifyFD = -1;
+    std::unordered_map<int, std::string>          m_mWatchedDirs; // inotify wd -> dir, ending in '/'
+    std::vector<std::string>                      m_vWatchedPaths; // configPaths, and where the symlinks among them point
+
     std::string currentCategory = "";  // For storing the category of the current item
 
     std::string parseError = "";  // For storing a parse error to display later
@@ -93,6 +128,9 @@ private:
     std::deque<SMonitorRule> m_dMonitorRules;
     std::deque<SWindowRule> m_dWindowRules;
 
+    // class + '\n' + title -> indices into m_dWindowRules, cleared whenever the rules change
+    std::unordered_map<std::string, std::vector<size_t>> m_mWindowRuleCache;
+
     bool firstExecDispatched = false;
     std::deque<std::string> firstExecRequests;
 
@@ -101,7 +139,10 @@ private:
 
     void                applyUserDefinedVars(std::string&, const size_t);
     void                loadConfigLoadVars();
-    SConfigValue        getConfigValueSafe(std::string);
+    void                updateWatches();
+    uint32_t            subsystemsForValue(const std::string&);
+    std::string         subsystemsToString(uint32_t);
+    const SConfigValue& getConfigValueSafe(const std::string&);
     void                parseLine(std::string&);
     void                configSetValueSafe(const std::string&, const std::string&);
     void                handleRawExec(const std::string&, const std::string&);
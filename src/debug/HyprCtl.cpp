@@ -11,19 +11,296 @@
 #include <unistd.h>
 #include <errno.h>
 
+#include <charconv>
 #include <string>
+#include <string_view>
+
+// Writes a reply as JSON or as the binary layout (see HyprCtl.hpp) into one buffer, without allocating per field.
+class CHyprCtlSerializer {
+  public:
+    CHyprCtlSerializer(HyprCtl::eHyprCtlOutputFormat format, size_t reserve) : m_eFormat(format) {
+        m_szBuffer.reserve(reserve);
+
+        if (m_eFormat == HyprCtl::FORMAT_BINARY) {
+            m_szBuffer.append(HyprCtl::BINARY_MAGIC, 4);
+            m_szBuffer.push_back((char)HyprCtl::BINARY_VERSION);
+        }
+    }
+
+    void beginList(const char* key = nullptr) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            m_szBuffer.push_back('[');
+        } else {
+            countItem();
+            writeRaw((uint32_t)0);
+        }
+
+        push();
+    }
+
+    void endList() {
+        pop();
+
+        if (m_eFormat == HyprCtl::FORMAT_JSON)
+            m_szBuffer.push_back(']');
+        else
+            patch(m_iOffsets[m_iDepth], m_iCounts[m_iDepth + 1]);
+    }
+
+    void beginObject(const char* key = nullptr) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            m_szBuffer.push_back('{');
+        } else {
+            countItem();
+            writeRaw((uint32_t)0);
+        }
+
+        push();
+    }
+
+    void endObject() {
+        pop();
+
+        if (m_eFormat == HyprCtl::FORMAT_JSON)
+            m_szBuffer.push_back('}');
+        else
+            patch(m_iOffsets[m_iDepth], m_szBuffer.length() - m_iOffsets[m_iDepth] - sizeof(uint32_t));
+    }
+
+    void field(const char* key, int64_t value) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            char buf[24];
+            const auto RESULT = std::to_chars(buf, buf + sizeof(buf), value);
+            m_szBuffer.append(buf, RESULT.ptr - buf);
+        } else {
+            countItem();
+            writeRaw(value);
+        }
+    }
+
+    void field(const char* key, int value) {
+        field(key, (int64_t)value);
+    }
+
+    void field(const char* key, uint64_t value) {
+        field(key, (int64_t)value);
+    }
+
+    void field(const char* key, double value) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            char buf[48];
+            const auto LEN = snprintf(buf, sizeof(buf), "%.5f", value);
+            m_szBuffer.append(buf, std::clamp(LEN, 0, (int)sizeof(buf) - 1));
+        } else {
+            countItem();
+            writeRaw(value);
+        }
+    }
+
+    void field(const char* key, bool value) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            m_szBuffer.append(value ? "true" : "false");
+        } else {
+            countItem();
+            m_szBuffer.push_back((char)value);
+        }
+    }
+
+    void field(const char* key, std::string_view value) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            jsonKey(key);
+            jsonString(value);
+        } else {
+            countItem();
+            writeRaw((uint32_t)value.length());
+            m_szBuffer.append(value.data(), value.length());
+        }
+    }
+
+    void field(const char* key, const char* value) {
+        field(key, std::string_view(value ? value : ""));
+    }
+
+    // pointers are written as "0x..." strings in json, as ints in binary
+    void address(const char* key, const void* value) {
+        if (m_eFormat == HyprCtl::FORMAT_JSON) {
+            char buf[24] = "0x";
+            const auto RESULT = std::to_chars(buf + 2, buf + sizeof(buf), (uintptr_t)value, 16);
+            field(key, std::string_view(buf, RESULT.ptr - buf));
+        } else
+            field(key, (int64_t)(uintptr_t)value);
+    }
+
+    std::string& result() {
+        return m_szBuffer;
+    }
+
+  private:
+    static constexpr int MAXDEPTH = 8;
+
+    void push() {
+        RASSERT(m_iDepth + 1 < MAXDEPTH, "CHyprCtlSerializer nested too deep");
+        m_iOffsets[m_iDepth] = m_szBuffer.length() - (m_eFormat == HyprCtl::FORMAT_BINARY ? sizeof(uint32_t) : 0);
+        m_iDepth++;
+        m_bFirst[m_iDepth] = true;
+        m_iCounts[m_iDepth] = 0;
+    }
+
+    void pop() {
+        m_iDepth--;
+    }
+
+    void countItem() {
+        m_iCounts[m_iDepth]++;
+    }
+
+    void jsonKey(const char* key) {
+        if (!m_bFirst[m_iDepth])
+            m_szBuffer.push_back(',');
+
+        m_bFirst[m_iDepth] = false;
+
+        if (key) {
+            jsonString(key);
+            m_szBuffer.push_back(':');
+        }
+    }
+
+    void jsonString(std::string_view str) {
+        m_szBuffer.push_back('"');
+
+        for (const char c : str) {
+            switch (c) {
+                case '"': m_szBuffer.append("\\\""); break;
+                case '\\': m_szBuffer.append("\\\\"); break;
+                case '\n': m_szBuffer.append("\\n"); break;
+                case '\t': m_szBuffer.append("\\t"); break;
+                default:
+                    if ((unsigned char)c < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", (unsigned int)c);
+                        m_szBuffer.append(buf, 6);
+                    } else
+                        m_szBuffer.push_back(c);
+            }
+        }
+
+        m_szBuffer.push_back('"');
+    }
+
+    template <typename T>
+    void writeRaw(T value) {
+        m_szBuffer.append((const char*)&value, sizeof(T));
+    }
+
+    void patch(size_t offset, size_t value) {
+        const uint32_t VAL = value;
+        memcpy(m_szBuffer.data() + offset, &VAL, sizeof(uint32_t));
+    }
+
+    HyprCtl::eHyprCtlOutputFormat m_eFormat;
+    std::string                   m_szBuffer;
+
+    int                           m_iDepth = 0;
+    size_t                        m_iOffsets[MAXDEPTH] = {0};
+    size_t                        m_iCounts[MAXDEPTH] = {0};
+    bool                          m_bFirst[MAXDEPTH] = {true};
+};
+
+// the workspace's name, straight from the workspace
+void workspaceNameField(CHyprCtlSerializer& out, const char* key, const int& id) {
+    if (id == -1) {
+        out.field(key, std::string_view());
+        return;
+    }
+
+    if (const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(id); PWORKSPACE) {
+        out.field(key, std::string_view(PWORKSPACE->m_szName));
+        return;
+    }
+
+    char buf[48];
+    const auto LEN = snprintf(buf, sizeof(buf), "Invalid workspace %d", id);
+    out.field(key, std::string_view(buf, std::clamp(LEN, 0, (int)sizeof(buf) - 1)));
+}
+
+void serializeWindow(CHyprCtlSerializer& out, CWindow* w) {
+    out.beginObject();
+    out.address("address", w);
+    out.field("title", w->m_szTitle);
+    out.field("x", (int)w->m_vRealPosition.vec().x);
+    out.field("y", (int)w->m_vRealPosition.vec().y);
+    out.field("width", (int)w->m_vRealSize.vec().x);
+    out.field("height", (int)w->m_vRealSize.vec().y);
+    out.field("workspace", w->m_iWorkspaceID);
+    workspaceNameField(out, "workspaceName", w->m_iWorkspaceID);
+    out.field("floating", (bool)w->m_bIsFloating);
+    out.field("monitor", (int)w->m_iMonitorID);
+    out.field("class", g_pXWaylandManager->getAppIDClassView(w));
+    out.endObject();
+}
+
+std::string monitorsRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 256 * g_pCompositor->m_lMonitors.size());
+
+        out.beginList();
+        for (auto& m : g_pCompositor->m_lMonitors) {
+            out.beginObject();
+            out.field("name", m.szName);
+            out.field("id", (uint64_t)m.ID);
+            out.field("width", (int)m.vecSize.x);
+            out.field("height", (int)m.vecSize.y);
+            out.field("refreshRate", (double)m.refreshRate);
+            out.field("x", (int)m.vecPosition.x);
+            out.field("y", (int)m.vecPosition.y);
+            out.field("activeWorkspace", m.activeWorkspace);
+            workspaceNameField(out, "activeWorkspaceName", m.activeWorkspace);
+            out.beginList("reserved");
+            out.field(nullptr, (int)m.vecReservedTopLeft.x);
+            out.field(nullptr, (int)m.vecReservedTopLeft.y);
+            out.field(nullptr, (int)m.vecReservedBottomRight.x);
+            out.field(nullptr, (int)m.vecReservedBottomRight.y);
+            out.endList();
+            // since BINARY_VERSION 2
+            out.field("directScanout", m.scanoutFallback == SCANOUT_OK);
+            out.field("scanoutFallback", g_pHyprRenderer->scanoutFallbackToString(m.scanoutFallback));
+            out.endObject();
+        }
+        out.endList();
+
+        return std::move(out.result());
+    }
 
-std::string monitorsRequest() {
     std::string result = "";
     for (auto& m : g_pCompositor->m_lMonitors) {
-        result += getFormat("Monitor %s (ID %i):\n\t%ix%i@%f at %ix%i\n\tactive workspace: %i (%s)\n\treserved: %i %i %i %i\n\n",
-                            m.szName.c_str(), m.ID, (int)m.vecSize.x, (int)m.vecSize.y, m.refreshRate, (int)m.vecPosition.x, (int)m.vecPosition.y, m.activeWorkspace, g_pCompositor->getWorkspaceByID(m.activeWorkspace)->m_szName.c_str(), (int)m.vecReservedTopLeft.x, (int)m.vecReservedTopLeft.y, (int)m.vecReservedBottomRight.x, (int)m.vecReservedBottomRight.y);
+        result += getFormat("Monitor %s (ID %i):\n\t%ix%i@%f at %ix%i\n\tactive workspace: %i (%s)\n\treserved: %i %i %i %i\n\tdirect scanout: %s\n\n",
+                            m.szName.c_str(), m.ID, (int)m.vecSize.x, (int)m.vecSize.y, m.refreshRate, (int)m.vecPosition.x, (int)m.vecPosition.y, m.activeWorkspace, g_pCompositor->getWorkspaceByID(m.activeWorkspace)->m_szName.c_str(), (int)m.vecReservedTopLeft.x, (int)m.vecReservedTopLeft.y, (int)m.vecReservedBottomRight.x, (int)m.vecReservedBottomRight.y,
+                            m.scanoutFallback == SCANOUT_OK ? "yes" : ("no, " + g_pHyprRenderer->scanoutFallbackToString(m.scanoutFallback)).c_str());
     }
 
     return result;
 }
 
-std::string clientsRequest() {
+std::string clientsRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 256 * g_pCompositor->m_lWindows.size());
+
+        out.beginList();
+        for (auto& w : g_pCompositor->m_lWindows) {
+            if (w.m_bIsMapped)
+                serializeWindow(out, &w);
+        }
+        out.endList();
+
+        return std::move(out.result());
+    }
+
     std::string result = "";
     for (auto& w : g_pCompositor->m_lWindows) {
         if (w.m_bIsMapped)
@@ -33,7 +310,27 @@ std::string clientsRequest() {
     return result;
 }
 
-std::string workspacesRequest() {
+std::string workspacesRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 128 * g_pCompositor->m_lWorkspaces.size());
+
+        out.beginList();
+        for (auto& w : g_pCompositor->m_lWorkspaces) {
+            const auto PMONITOR = g_pCompositor->getMonitorFromID(w.m_iMonitorID);
+
+            out.beginObject();
+            out.field("id", w.m_iID);
+            out.field("name", w.m_szName);
+            out.field("monitor", PMONITOR ? PMONITOR->szName.c_str() : "");
+            out.field("windows", g_pCompositor->getWindowsOnWorkspace(w.m_iID));
+            out.field("hasfullscreen", (bool)w.m_bHasFullscreenWindow);
+            out.endObject();
+        }
+        out.endList();
+
+        return std::move(out.result());
+    }
+
     std::string result = "";
     for (auto& w : g_pCompositor->m_lWorkspaces) {
         result += getFormat("workspace ID %i (%s) on monitor %s:\n\twindows: %i\n\thasfullscreen: %i\n\n",
@@ -42,9 +339,23 @@ std::string workspacesRequest() {
     return result;
 }
 
-std::string activeWindowRequest() {
+std::string activeWindowRequest(HyprCtl::eHyprCtlOutputFormat format) {
     const auto PWINDOW = g_pCompositor->m_pLastWindow;
 
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 256);
+
+        // an empty object when there's no active window
+        if (g_pCompositor->windowValidMapped(PWINDOW))
+            serializeWindow(out, PWINDOW);
+        else {
+            out.beginObject();
+            out.endObject();
+        }
+
+        return std::move(out.result());
+    }
+
     if (!g_pCompositor->windowValidMapped(PWINDOW))
         return "Invalid";
 
@@ -52,7 +363,36 @@ std::string activeWindowRequest() {
                         PWINDOW, PWINDOW->m_szTitle.c_str(), (int)PWINDOW->m_vRealPosition.vec().x, (int)PWINDOW->m_vRealPosition.vec().y, (int)PWINDOW->m_vRealSize.vec().x, (int)PWINDOW->m_vRealSize.vec().y, PWINDOW->m_iWorkspaceID, (PWINDOW->m_iWorkspaceID == -1 ? "" : g_pCompositor->getWorkspaceByID(PWINDOW->m_iWorkspaceID)->m_szName.c_str()), (int)PWINDOW->m_bIsFloating, (int)PWINDOW->m_iMonitorID, g_pXWaylandManager->getAppIDClass(PWINDOW).c_str());
 }
 
-std::string layersRequest() {
+std::string layersRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 1024 * g_pCompositor->m_lMonitors.size());
+
+        out.beginList();
+        for (auto& mon : g_pCompositor->m_lMonitors) {
+            out.beginObject();
+            out.field("monitor", mon.szName);
+            out.beginList("levels");
+            for (auto& level : mon.m_aLayerSurfaceLists) {
+                out.beginList();
+                for (auto& layer : level) {
+                    out.beginObject();
+                    out.address("address", layer);
+                    out.field("x", layer->geometry.x);
+                    out.field("y", layer->geometry.y);
+                    out.field("w", layer->geometry.width);
+                    out.field("h", layer->geometry.height);
+                    out.endObject();
+                }
+                out.endList();
+            }
+            out.endList();
+            out.endObject();
+        }
+        out.endList();
+
+        return std::move(out.result());
+    }
+
     std::string result = "";
 
     for (auto& mon : g_pCompositor->m_lMonitors) {
@@ -73,7 +413,63 @@ std::string layersRequest() {
     return result;
 }
 
-std::string devicesRequest() {
+std::string devicesRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    if (format != HyprCtl::FORMAT_NORMAL) {
+        CHyprCtlSerializer out(format, 2048);
+
+        out.beginObject();
+
+        out.beginList("mice");
+        for (auto& m : g_pInputManager->m_lMice) {
+            out.beginObject();
+            out.address("address", &m);
+            out.field("name", m.mouse->name);
+            out.endObject();
+        }
+        out.endList();
+
+        out.beginList("keyboards");
+        for (auto& k : g_pInputManager->m_lKeyboards) {
+            out.beginObject();
+            out.address("address", &k);
+            out.field("name", k.keyboard->name);
+            out.endObject();
+        }
+        out.endList();
+
+        out.beginList("tabletPads");
+        for (auto& d : g_pInputManager->m_lTabletPads) {
+            out.beginObject();
+            out.address("address", &d);
+            out.address("tablet", d.pTabletParent);
+            out.field("name", d.pTabletParent && d.pTabletParent->wlrDevice ? d.pTabletParent->wlrDevice->name : "");
+            out.endObject();
+        }
+        out.endList();
+
+        out.beginList("tablets");
+        for (auto& d : g_pInputManager->m_lTablets) {
+            out.beginObject();
+            out.address("address", &d);
+            out.field("name", d.wlrDevice ? d.wlrDevice->name : "");
+            out.endObject();
+        }
+        out.endList();
+
+        out.beginList("tabletTools");
+        for (auto& d : g_pInputManager->m_lTabletTools) {
+            out.beginObject();
+            out.address("address", &d);
+            out.address("tablet", d.wlrTabletTool ? d.wlrTabletTool->data : nullptr);
+            out.endObject();
+        }
+        out.endList();
+
+        out.endObject();
+
+        return std::move(out.result());
+    }
+
     std::string result = "";
 
     result += "mice:\n";
@@ -125,20 +521,32 @@ std::string versionRequest() {
 }
 
 std::string dispatchRequest(std::string in) {
+    // scripts send the same few commands over and over, keep them compiled
+    static std::unordered_map<std::string, SDispatchCommand> compiledDispatches;
+
     // get rid of the dispatch keyword
     in = in.substr(in.find_first_of(' ') + 1);
 
-    const auto DISPATCHSTR = in.substr(0, in.find_first_of(' '));
+    auto COMPILED = compiledDispatches.find(in);
+
+    if (COMPILED == compiledDispatches.end()) {
+        const auto DISPATCHSTR = in.substr(0, in.find_first_of(' '));
 
-    const auto DISPATCHARG = in.substr(in.find_first_of(' ') + 1);
+        const auto DISPATCHARG = in.substr(in.find_first_of(' ') + 1);
 
-    const auto DISPATCHER = g_pKeybindManager->m_mDispatchers.find(DISPATCHSTR);
-    if (DISPATCHER == g_pKeybindManager->m_mDispatchers.end())
-        return "Invalid dispatcher";
+        auto command = g_pKeybindManager->compileDispatch(DISPATCHSTR, DISPATCHARG);
+        if (!command.dispatcher)
+            return "Invalid dispatcher";
 
-    DISPATCHER->second(DISPATCHARG);
+        if (compiledDispatches.size() > 512)
+            compiledDispatches.clear();
 
-    Debug::log(LOG, "Hyprctl: dispatcher %s : %s", DISPATCHSTR.c_str(), DISPATCHARG.c_str());
+        COMPILED = compiledDispatches.emplace(in, std::move(command)).first;
+    }
+
+    g_pKeybindManager->executeDispatch(COMPILED->second);
+
+    Debug::log(LOG, "Hyprctl: dispatcher %s", in.c_str());
 
     return "ok";
 }
@@ -168,62 +576,75 @@ std::string dispatchKeyword(std::string in) {
 }
 
 std::string reloadRequest() {
-    g_pConfigManager->m_bForceReload = true;
+    g_pConfigManager->reload();
 
     return "ok";
 }
 
-std::string getReply(std::string);
-
 std::string dispatchBatch(std::string request) {
-    // split by ;
-
-    request = request.substr(9);
+    // split by ;, walking an offset: cutting the rest off every time is quadratic in a 100k command batch
+    size_t      pos = 9; // past [[BATCH]]
     std::string curitem = "";
     std::string reply = "";
 
     auto nextItem = [&]() {
-        auto idx = request.find_first_of(';');
-
-        if (idx != std::string::npos) {
-            curitem = request.substr(0, idx);
-            request = request.substr(idx + 1);
-        } else {
-            curitem = request;
-            request = "";
-        }
+        const auto IDX = request.find_first_of(';', pos);
+        const auto END = IDX == std::string::npos ? request.length() : IDX;
 
-        curitem = removeBeginEndSpacesTabs(curitem);
+        curitem = removeBeginEndSpacesTabs(request.substr(pos, END - pos));
+        pos = END == request.length() ? END : END + 1;
     };
 
     nextItem();
 
-    while (curitem != "") {
-        reply += getReply(curitem);
+    // relayout, redraw and notify once for the whole batch, not once per command
+    g_pCompositor->beginBatch();
+
+    try {
+        while (curitem != "") {
+            reply += HyprCtl::getReply(curitem);
 
-        nextItem();
+            nextItem();
+        }
+    } catch (...) {
+        // don't leave everything held back
+        g_pCompositor->endBatch();
+        throw;
     }
 
+    g_pCompositor->endBatch();
+
     return reply;
 }
 
-std::string getReply(std::string request) {
+std::string HyprCtl::getReply(std::string request) {
+    auto format = HyprCtl::FORMAT_NORMAL;
+
+    // "j/" or "b/" in front of a query picks the output format
+    if (request.find("j/") == 0) {
+        format = HyprCtl::FORMAT_JSON;
+        request = request.substr(2);
+    } else if (request.find("b/") == 0) {
+        format = HyprCtl::FORMAT_BINARY;
+        request = request.substr(2);
+    }
+
     if (request == "monitors")
-        return monitorsRequest();
+        return monitorsRequest(format);
     else if (request == "workspaces")
-        return workspacesRequest();
+        return workspacesRequest(format);
     else if (request == "clients")
-        return clientsRequest();
+        return clientsRequest(format);
     else if (request == "activewindow")
-        return activeWindowRequest();
+        return activeWindowRequest(format);
     else if (request == "layers")
-        return layersRequest();
+        return layersRequest(format);
     else if (request == "version")
         return versionRequest();
     else if (request == "reload")
         return reloadRequest();
     else if (request == "devices")
-        return devicesRequest();
+        return devicesRequest(format);
     else if (request.find("dispatch") == 0)
         return dispatchRequest(request);
     else if (request.find("keyword") == 0)
@@ -234,94 +655,200 @@ std::string getReply(std::string request) {
     return "unknown request";
 }
 
-void HyprCtl::tickHyprCtl() {
-    if (!requestMade)
-        return;
-
-    std::string reply = "";
-
+std::string getReplySafe(const std::string& request) {
     try {
-        reply = getReply(request);
+        return HyprCtl::getReply(request);
     } catch (std::exception& e) {
         Debug::log(ERR, "Error in request: %s", e.what());
-        reply = "Err: " + std::string(e.what());
+        return "Err: " + std::string(e.what());
     }
+}
+
+// A request is everything the client sends until it shuts down its write end (hyprctl does), the reply is
+// everything we send until we close. Clients that never shut down get answered with what they sent once
+// they've been quiet for HYPRCTL_CLIENT_TIMEOUT, idle ones without a request are dropped then.
+// HYPRCTL_MAX_REQUEST only guards the memory, a 100k command [[BATCH]] is a few MB.
+constexpr size_t HYPRCTL_MAX_REQUEST    = 64 * 1024 * 1024;
+constexpr int    HYPRCTL_CLIENT_TIMEOUT = 5000; // ms
+
+struct SHyprCtlClient {
+    int              fd = -1;
+    wl_event_source* source = nullptr;
+    wl_event_source* timer = nullptr;
+    std::string      request = "";
+    std::string      reply = "";
+    size_t           replyWritten = 0;
+};
+
+void closeHyprCtlClient(SHyprCtlClient* pClient) {
+    if (pClient->source)
+        wl_event_source_remove(pClient->source);
 
-    request = reply;
+    if (pClient->timer)
+        wl_event_source_remove(pClient->timer);
 
-    requestMade = false;
-    requestReady = true;
+    close(pClient->fd);
+
+    delete pClient;
 }
 
-std::string getRequestFromThread(std::string rq) {
-    while (HyprCtl::request != "" || HyprCtl::requestMade || HyprCtl::requestReady) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+// false if the client got closed
+bool answerHyprCtlClient(SHyprCtlClient* pClient) {
+    if (pClient->reply.empty())
+        pClient->reply = getReplySafe(pClient->request);
+
+    if (pClient->reply.empty()) {
+        closeHyprCtlClient(pClient);
+        return false;
     }
 
-    HyprCtl::request = rq;
-    HyprCtl::requestMade = true;
+    wl_event_source_fd_update(pClient->source, WL_EVENT_WRITABLE);
+    return true;
+}
 
-    while (!HyprCtl::requestReady) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+int onHyprCtlClientTimeout(void* data) {
+    const auto PCLIENT = (SHyprCtlClient*)data;
 
-    HyprCtl::requestReady = false;
-    HyprCtl::requestMade = false;
+    if (!PCLIENT->request.empty() && PCLIENT->reply.empty()) {
+        Debug::log(LOG, "hyprctl client on fd %d didn't shut down its write end, answering what it sent", PCLIENT->fd);
 
-    std::string toReturn = HyprCtl::request;
+        if (answerHyprCtlClient(PCLIENT))
+            wl_event_source_timer_update(PCLIENT->timer, HYPRCTL_CLIENT_TIMEOUT);
 
-    HyprCtl::request = "";
+        return 0;
+    }
 
-    return toReturn;
-}
+    Debug::log(WARN, "hyprctl client on fd %d timed out, closing", PCLIENT->fd);
 
-void HyprCtl::startHyprCtlSocket() {
-    std::thread([&]() {
-        const auto SOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
+    closeHyprCtlClient(PCLIENT);
 
-        if (SOCKET < 0) {
-            Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
-            return;
-        }
+    return 0;
+}
 
-        sockaddr_un SERVERADDRESS = {.sun_family = AF_UNIX};
+int onHyprCtlClientEvent(int fd, uint32_t mask, void* data) {
+    const auto PCLIENT = (SHyprCtlClient*)data;
 
-        std::string socketPath = "/tmp/hypr/" + g_pCompositor->m_szInstanceSignature + "/.socket.sock";
+    if (mask & WL_EVENT_ERROR) {
+        closeHyprCtlClient(PCLIENT);
+        return 0;
+    }
+
+    // any activity pushes the deadline back
+    wl_event_source_timer_update(PCLIENT->timer, HYPRCTL_CLIENT_TIMEOUT);
 
-        strcpy(SERVERADDRESS.sun_path, socketPath.c_str());
+    if (mask & (WL_EVENT_READABLE | WL_EVENT_HANGUP) && PCLIENT->reply.empty()) {
+        static char readBuffer[65536];
 
-        bind(SOCKET, (sockaddr*)&SERVERADDRESS, SUN_LEN(&SERVERADDRESS));
+        while (1) {
+            const auto SIZEREAD = read(fd, readBuffer, sizeof(readBuffer));
 
-        // 10 max queued.
-        listen(SOCKET, 10);
+            if (SIZEREAD > 0) {
+                PCLIENT->request.append(readBuffer, SIZEREAD);
 
-        sockaddr_in clientAddress;
-        socklen_t clientSize = sizeof(clientAddress);
+                if (PCLIENT->request.length() > HYPRCTL_MAX_REQUEST) {
+                    Debug::log(ERR, "hyprctl request on fd %d is over %zu bytes, refusing it", fd, HYPRCTL_MAX_REQUEST);
+                    PCLIENT->reply = "Err: request too large";
+                    break;
+                }
 
-        char readBuffer[1024] = {0};
+                continue;
+            }
 
-        Debug::log(LOG, "Hypr socket started at %s", socketPath.c_str());
+            if (SIZEREAD < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                return 0; // the rest is still on its way
 
-        while(1) {
-            const auto ACCEPTEDCONNECTION = accept(SOCKET, (sockaddr*)&clientAddress, &clientSize);
+            if (SIZEREAD < 0 && errno == EINTR)
+                continue;
 
-            if (ACCEPTEDCONNECTION < 0) {
-                Debug::log(ERR, "Couldn't listen on the Hyprland Socket. (3) IPC will not work.");
-                break;
+            if (SIZEREAD < 0) {
+                closeHyprCtlClient(PCLIENT);
+                return 0;
             }
 
-            auto messageSize = read(ACCEPTEDCONNECTION, readBuffer, 1024);
-            readBuffer[messageSize == 1024 ? 1023 : messageSize] = '\0';
+            break; // EOF, the request is complete
+        }
+
+        if (!answerHyprCtlClient(PCLIENT))
+            return 0;
+    }
+
+    if (PCLIENT->reply.empty())
+        return 0;
+
+    // write as much as we can, the rest when it becomes writable again
+    while (PCLIENT->replyWritten < PCLIENT->reply.length()) {
+        const auto WRITTEN = send(fd, PCLIENT->reply.data() + PCLIENT->replyWritten, PCLIENT->reply.length() - PCLIENT->replyWritten, MSG_NOSIGNAL);
+
+        if (WRITTEN < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return 0;
+
+            break;
+        }
+
+        PCLIENT->replyWritten += WRITTEN;
+    }
+
+    closeHyprCtlClient(PCLIENT);
 
-            std::string request(readBuffer);
+    return 0;
+}
+
+int onHyprCtlSocketAccept(int fd, uint32_t mask, void* data) {
+    sockaddr_in clientAddress;
+    socklen_t clientSize = sizeof(clientAddress);
+
+    while (1) {
+        const auto ACCEPTEDCONNECTION = accept4(fd, (sockaddr*)&clientAddress, &clientSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
 
-            std::string reply = getRequestFromThread(request);
-            
-            write(ACCEPTEDCONNECTION, reply.c_str(), reply.length());
+        if (ACCEPTEDCONNECTION < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                Debug::log(ERR, "Couldn't accept on the Hyprland Socket. (3) errno %d", errno);
+            break;
+        }
+
+        const auto PCLIENT = new SHyprCtlClient;
+        PCLIENT->fd = ACCEPTEDCONNECTION;
+        PCLIENT->source = wl_event_loop_add_fd(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), ACCEPTEDCONNECTION, WL_EVENT_READABLE, onHyprCtlClientEvent, PCLIENT);
+        PCLIENT->timer = wl_event_loop_add_timer(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), onHyprCtlClientTimeout, PCLIENT);
 
-            close(ACCEPTEDCONNECTION);
+        if (!PCLIENT->source || !PCLIENT->timer) {
+            Debug::log(ERR, "Couldn't add a hyprctl client to the event loop");
+            closeHyprCtlClient(PCLIENT);
+            continue;
         }
 
+        wl_event_source_timer_update(PCLIENT->timer, HYPRCTL_CLIENT_TIMEOUT);
+    }
+
+    return 0;
+}
+
+void HyprCtl::startHyprCtlSocket() {
+    const auto SOCKET = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (SOCKET < 0) {
+        Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
+        return;
+    }
+
+    sockaddr_un SERVERADDRESS = {.sun_family = AF_UNIX};
+
+    std::string socketPath = "/tmp/hypr/" + g_pCompositor->m_szInstanceSignature + "/.socket.sock";
+
+    strcpy(SERVERADDRESS.sun_path, socketPath.c_str());
+
+    bind(SOCKET, (sockaddr*)&SERVERADDRESS, SUN_LEN(&SERVERADDRESS));
+
+    // 10 max queued.
+    listen(SOCKET, 10);
+
+    // requests get answered on the main thread, right as they come in
+    if (!wl_event_loop_add_fd(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), SOCKET, WL_EVENT_READABLE, onHyprCtlSocketAccept, nullptr)) {
+        Debug::log(ERR, "Couldn't add the Hyprland Socket to the event loop. (2) IPC will not work.");
         close(SOCKET);
-    }).detach();
-}
\ No newline at end of file
+        return;
+    }
+
+    Debug::log(LOG, "Hypr socket started at %s", socketPath.c_str());
+}
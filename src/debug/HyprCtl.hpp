@@ -5,13 +5,44 @@
 #include "../helpers/MiscFunctions.hpp"
 
 namespace HyprCtl {
-    void            startHyprCtlSocket();
-    void            tickHyprCtl();
+    enum eHyprCtlOutputFormat {
+        FORMAT_NORMAL = 0,
+        FORMAT_JSON,
+        FORMAT_BINARY
+    };
+
+    // Binary replies ("b/" in front of the query) start with the 4 bytes of BINARY_MAGIC and a uint8 BINARY_VERSION.
+    // Everything is native-endian and carries no keys, the fields are where the layout below puts them:
+    //   int      int64            bool     uint8
+    //   double   float64          string   uint32 byte length, then the bytes (no terminator)
+    //   address  int64, the pointer as json prints it in hex
+    //   list     uint32 item count, then the items
+    //   object   uint32 byte length of all its fields, then the fields
+    // An object's length covers everything in it, nested lists too, so a reader that knows fewer fields than
+    // were sent skips to the next object by the length. Bump the version when a layout changes, new fields go
+    // at the end of their object.
+    //
+    // monitors     list of {name string, id int, width int, height int, refreshRate double, x int, y int,
+    //                       activeWorkspace int, activeWorkspaceName string, reserved list of 4 int,
+    //                       directScanout bool, scanoutFallback string}
+    // workspaces   list of {id int, name string, monitor string, windows int, hasfullscreen bool}
+    // clients      list of window
+    // activewindow window, or an object of length 0 if there's none
+    // layers       list of {monitor string, levels list of 4 list of {address, x int, y int, w int, h int}}
+    // devices      {mice list of {address, name string}, keyboards list of {address, name string},
+    //               tabletPads list of {address, tablet address, name string}, tablets list of {address, name string},
+    //               tabletTools list of {address, tablet address}}
+    //
+    // window       {address, title string, x int, y int, width int, height int, workspace int, workspaceName string,
+    //               floating bool, monitor int, class string}
+    //
+    // 2: monitors end with directScanout, scanoutFallback
+    inline const char*  BINARY_MAGIC = "HCTL";
+    inline const uint8_t BINARY_VERSION = 2;
 
-    // very simple thread-safe request method
-    inline  bool    requestMade = false;
-    inline  bool    requestReady = false;
-    inline  std::string request = "";
+    // adds the socket to the wayland event loop, requests are handled on the main thread
+    void            startHyprCtlSocket();
 
-    inline std::ifstream requestStream;
+    // the reply to a request, as it goes out on the socket. Throws what the request throws.
+    std::string     getReply(std::string);
 };
\ No newline at end of file
@@ -33,6 +33,36 @@ void CHyprMonitorDebugOverlay::frameData(SMonitor* pMonitor) {
         m_pMonitor = pMonitor;
 }
 
+void CHyprMonitorDebugOverlay::frameStats(SMonitor* pMonitor, const SFrameRenderStats& stats) {
+    m_sLastFrameStats = stats;
+
+    if (!m_pMonitor)
+        m_pMonitor = pMonitor;
+}
+
+void CHyprMonitorDebugOverlay::framePacing(SMonitor* pMonitor, float errorMs, bool missed) {
+    m_dLastPresentationErrors.push_back(errorMs);
+
+    if (m_dLastPresentationErrors.size() > (long unsigned int)pMonitor->refreshRate)
+        m_dLastPresentationErrors.pop_front();
+
+    if (missed)
+        m_iMissedDeadlines++;
+
+    if (!m_pMonitor)
+        m_pMonitor = pMonitor;
+}
+
+void CHyprMonitorDebugOverlay::frameStageTimes(SMonitor* pMonitor, const SFrameStageTimes& times) {
+    m_dLastStageTimes.push_back(times);
+
+    if (m_dLastStageTimes.size() > (long unsigned int)pMonitor->refreshRate)
+        m_dLastStageTimes.pop_front();
+
+    if (!m_pMonitor)
+        m_pMonitor = pMonitor;
+}
+
 int CHyprMonitorDebugOverlay::draw(int offset) {
 
     if (!m_pMonitor)
@@ -62,6 +92,22 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     }
     avgRenderTimeNoOverlay /= m_dLastRenderTimes.size() == 0 ? 1 : m_dLastRenderTimes.size();
 
+    // jitter = how far presentations land from where we predicted them, on average
+    float avgJitter = 0;
+    for (auto& pe : m_dLastPresentationErrors) {
+        avgJitter += std::abs(pe);
+    }
+    avgJitter /= m_dLastPresentationErrors.size() == 0 ? 1 : m_dLastPresentationErrors.size();
+
+    SFrameStageTimes avgStageTimes;
+    for (auto& st : m_dLastStageTimes) {
+        avgStageTimes.animations += st.animations;
+        avgStageTimes.prepare += st.prepare;
+        avgStageTimes.render += st.render;
+        avgStageTimes.commit += st.commit;
+    }
+    const float STAGESAMPLES = m_dLastStageTimes.size() == 0 ? 1 : m_dLastStageTimes.size();
+
     const float FPS = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
     const float idealFPS = m_dLastFrametimes.size();
 
@@ -118,7 +164,71 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     if (cairoExtents.width > maxX) maxX = cairoExtents.width;
 
     yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Stages: anim " + std::to_string((int)(avgStageTimes.animations / STAGESAMPLES * 1000.f)) + "us, prep " + std::to_string((int)(avgStageTimes.prepare / STAGESAMPLES * 1000.f)) + "us, render " + std::to_string((int)(avgStageTimes.render / STAGESAMPLES * 1000.f)) + "us, commit " + std::to_string((int)(avgStageTimes.commit / STAGESAMPLES * 1000.f)) + "us");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Frame prep: " + std::to_string((int)m_sLastFrameStats.framePrepWorkUs) + "us of region math on " + std::to_string(m_sLastFrameStats.framePrepThreads) + " workers + main");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
 
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Draw calls: " + std::to_string(m_sLastFrameStats.drawCalls) + " (" + std::to_string(m_sLastFrameStats.quadsSkipped) + " quads skipped)");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Uniform uploads: " + std::to_string(m_sLastFrameStats.uniformUploads) + " (" + std::to_string(m_sLastFrameStats.uniformUploadsAvoided) + " avoided)");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Blur: " + std::to_string(m_sLastFrameStats.blurPasses) + " passes, " + std::to_string(m_sLastFrameStats.blurPasses == 0 ? 0 : m_sLastFrameStats.blurPixels / m_sLastFrameStats.blurPasses) + " px/pass");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Damage: " + std::to_string(m_sLastFrameStats.damageRectsRaw) + " rects, " + std::to_string(m_sLastFrameStats.damageRectsMerged) + " merged");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Occlusion: " + std::to_string(m_sLastFrameStats.surfacesCulled) + " surfaces culled, " + std::to_string(m_sLastFrameStats.pixelsOccluded) + " px saved");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Render list: " + std::to_string(m_sLastFrameStats.renderListItems) + " windows, " + (m_sLastFrameStats.renderListRebuilt ? "rebuilt" : "reused") + " (last build " + std::to_string((int)m_sLastFrameStats.renderListBuildTimeUs) + "us)");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+    text = std::string("Frame pacing: " + std::to_string((int)avgJitter) + "." + std::to_string((int)(avgJitter * 10.f) % 10) + "ms jitter, " + std::to_string(m_iMissedDeadlines) + " missed");
+    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+    if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+
+    yOffset += 11;
+
+    // the overlay isn't part of the scene, don't make the render lists rebuild every frame
     g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
     m_wbLastDrawnBox = {(int)g_pCompositor->m_lMonitors.front().vecPosition.x, (int)g_pCompositor->m_lMonitors.front().vecPosition.y + offset - 1, (int)maxX + 2, yOffset - offset + 2};
     g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
@@ -138,6 +248,18 @@ void CHyprDebugOverlay::frameData(SMonitor* pMonitor) {
     m_mMonitorOverlays[pMonitor].frameData(pMonitor);
 }
 
+void CHyprDebugOverlay::frameStats(SMonitor* pMonitor, const SFrameRenderStats& stats) {
+    m_mMonitorOverlays[pMonitor].frameStats(pMonitor, stats);
+}
+
+void CHyprDebugOverlay::frameStageTimes(SMonitor* pMonitor, const SFrameStageTimes& times) {
+    m_mMonitorOverlays[pMonitor].frameStageTimes(pMonitor, times);
+}
+
+void CHyprDebugOverlay::framePacing(SMonitor* pMonitor, float errorMs, bool missed) {
+    m_mMonitorOverlays[pMonitor].framePacing(pMonitor, errorMs, missed);
+}
+
 void CHyprDebugOverlay::draw() {
 
     const auto PMONITOR = &g_pCompositor->m_lMonitors.front();
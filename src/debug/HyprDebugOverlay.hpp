@@ -3,10 +3,19 @@
 #include "../defines.hpp"
 #include "../helpers/Monitor.hpp"
 #include "../render/Texture.hpp"
+#include "../render/OpenGL.hpp"
 #include <deque>
 #include <cairo/cairo.h>
 #include <unordered_map>
 
+// where a frame spends its time, in ms
+struct SFrameStageTimes {
+    float animations = 0;
+    float prepare = 0; // render list, damage, blur expansion and occlusion, the main thread's part of it. No GL.
+    float render = 0;  // GL submission, overlay included
+    float commit = 0;  // frame damage and the output commit
+};
+
 class CHyprMonitorDebugOverlay {
 public:
     int draw(int offset);
@@ -14,11 +23,18 @@ public:
     void renderData(SMonitor* pMonitor, float µs);
     void renderDataNoOverlay(SMonitor* pMonitor, float µs);
     void frameData(SMonitor* pMonitor);
+    void frameStats(SMonitor* pMonitor, const SFrameRenderStats& stats);
+    void framePacing(SMonitor* pMonitor, float errorMs, bool missed);
+    void frameStageTimes(SMonitor* pMonitor, const SFrameStageTimes& times);
 
 private:
+    SFrameRenderStats m_sLastFrameStats;
+    std::deque<SFrameStageTimes> m_dLastStageTimes;
     std::deque<float> m_dLastFrametimes;
     std::deque<float> m_dLastRenderTimes;
     std::deque<float> m_dLastRenderTimesNoOverlay;
+    std::deque<float> m_dLastPresentationErrors;
+    int m_iMissedDeadlines = 0;
     std::chrono::high_resolution_clock::time_point m_tpLastFrame;
     SMonitor* m_pMonitor = nullptr;
     wlr_box m_wbLastDrawnBox;
@@ -31,6 +47,9 @@ public:
     void renderData(SMonitor*, float µs);
     void renderDataNoOverlay(SMonitor*, float µs);
     void frameData(SMonitor*);
+    void frameStats(SMonitor*, const SFrameRenderStats&);
+    void framePacing(SMonitor*, float errorMs, bool missed);
+    void frameStageTimes(SMonitor*, const SFrameStageTimes&);
 
 private:
 
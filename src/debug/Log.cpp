@@ -2,41 +2,156 @@
 #include "../defines.hpp"
 #include "../Compositor.hpp"
 
-#include <fstream>
-#include <iostream>
+#include <condition_variable>
+#include <csignal>
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+// wake the log thread early when this much is waiting
+constexpr size_t LOG_FLUSH_THRESHOLD = 64 * 1024;
+// past this, the log thread can't keep up and lines get dropped
+constexpr size_t LOG_MAX_PENDING = 8 * 1024 * 1024;
+// how often the log thread writes out whatever's pending
+constexpr std::chrono::milliseconds LOG_FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+// filled by log(), guarded by bufferMutex, which is never held during I/O
+std::mutex              bufferMutex;
+std::condition_variable bufferCV;
+std::string             pendingBuffer;
+size_t                  droppedLines = 0;
+bool                    stopLogThread = false;
+bool                    flushRequested = false; // an error came in, write it out now instead of at the next interval
+
+// held while writing, so batches land in the order they were taken
+std::mutex              writeMutex;
+std::string             writeBuffer;
+int                     logFD = -1;
+
+// joined in the atexit handler, before any of the above gets destroyed
+std::thread             logThread;
+
+void writeAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        const auto WRITTEN = write(fd, data, len);
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return;
+        }
+
+        data += WRITTEN;
+        len -= WRITTEN;
+    }
+}
+
+// takes whatever is pending and writes it out. Blocks on I/O, never call with bufferMutex held.
+void writePending() {
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+
+    size_t dropped = 0;
+
+    {
+        std::lock_guard<std::mutex> bufferLock(bufferMutex);
+        writeBuffer.swap(pendingBuffer);
+        dropped = droppedLines;
+        droppedLines = 0;
+    }
+
+    if (dropped > 0)
+        writeBuffer += "[WARN] " + std::to_string(dropped) + " log lines were dropped, the log couldn't keep up\n";
+
+    if (writeBuffer.empty())
+        return;
+
+    // the instance dir might not exist yet when we start, so open on first write
+    if (logFD < 0)
+        logFD = open(Debug::logFile.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+    if (logFD >= 0)
+        writeAll(logFD, writeBuffer.data(), writeBuffer.length());
+
+    // log it to the stdout too.
+    writeAll(STDOUT_FILENO, writeBuffer.data(), writeBuffer.length());
+
+    writeBuffer.clear(); // keeps the capacity for the next swap
+}
+
+// SIGSEGV / SIGABRT: write out what's pending without waiting on anyone, then die the normal way.
+// If the crashing thread holds the buffer lock the buffer may be mid-append, so we don't touch it.
+void onCrashSignal(int signo) {
+    if (bufferMutex.try_lock()) {
+        if (logFD < 0)
+            logFD = open(Debug::logFile.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+        if (logFD >= 0)
+            writeAll(logFD, pendingBuffer.data(), pendingBuffer.length());
+
+        writeAll(STDOUT_FILENO, pendingBuffer.data(), pendingBuffer.length());
+
+        pendingBuffer.clear();
+        // left locked on purpose, nothing should log after this
+    }
+
+    signal(signo, SIG_DFL);
+    raise(signo);
+}
+
+void stopAndFlush() {
+    {
+        std::lock_guard<std::mutex> lg(bufferMutex);
+        stopLogThread = true;
+    }
+
+    bufferCV.notify_one();
+
+    if (logThread.joinable())
+        logThread.join();
+
+    writePending();
+}
 
 void Debug::init(std::string IS) {
     if (ISDEBUG)
         logFile = "/tmp/hypr/" + IS + "/hyprlandd.log";
     else
         logFile = "/tmp/hypr/" + IS + "/hyprland.log";
+
+    pendingBuffer.reserve(LOG_FLUSH_THRESHOLD * 2);
+    writeBuffer.reserve(LOG_FLUSH_THRESHOLD * 2);
+
+    logThread = std::thread([]() {
+        while (1) {
+            {
+                std::unique_lock<std::mutex> lk(bufferMutex);
+                bufferCV.wait_for(lk, LOG_FLUSH_INTERVAL, []() { return stopLogThread || flushRequested || pendingBuffer.length() >= LOG_FLUSH_THRESHOLD; });
+
+                if (stopLogThread)
+                    return;
+
+                flushRequested = false;
+            }
+
+            writePending();
+        }
+    });
+
+    // exit() and RIP() shouldn't lose the tail of the log, and the thread has to be gone before the statics are
+    atexit(stopAndFlush);
+
+    signal(SIGSEGV, onCrashSignal);
+    signal(SIGABRT, onCrashSignal);
 }
 
-void Debug::log(LogLevel level, const char* fmt, ...) {
-
-    // log to a file
-    std::ofstream ofs;
-    ofs.open(logFile, std::ios::out | std::ios::app);
-
-    switch (level) {
-        case LOG:
-            ofs << "[LOG] ";
-            break;
-        case WARN:
-            ofs << "[WARN] ";
-            break;
-        case ERR:
-            ofs << "[ERR] ";
-            break;
-        case CRIT:
-            ofs << "[CRITICAL] ";
-            break;
-        default:
-            break;
-    }
+void Debug::flush() {
+    writePending();
+}
 
+void Debug::logImpl(LogLevel level, const char* fmt, ...) {
     char buf[LOGMESSAGESIZE] = "";
-    char* outputStr;
     int logLen;
 
     va_list args;
@@ -44,28 +159,59 @@ void Debug::log(LogLevel level, const char* fmt, ...) {
     logLen = vsnprintf(buf, sizeof buf, fmt, args);
     va_end(args);
 
-    if ((long unsigned int)logLen < sizeof buf) {
-        outputStr = strdup(buf);
-    } else {
-        outputStr = (char*)malloc(logLen + 1);
+    if (logLen < 0)
+        return;
 
-        if (!outputStr) {
-            printf("CRITICAL: Cannot alloc size %d for log! (Out of memory?)", logLen + 1);
+    bool wakeUp = false;
+
+    {
+        std::lock_guard<std::mutex> lg(bufferMutex);
+
+        if (pendingBuffer.length() > LOG_MAX_PENDING) {
+            droppedLines++;
             return;
         }
 
-        va_start(args, fmt);
-        vsnprintf(outputStr, logLen + 1U, fmt, args);
-        va_end(args);
-    }
+        switch (level) {
+            case LOG:
+                pendingBuffer += "[LOG] ";
+                break;
+            case WARN:
+                pendingBuffer += "[WARN] ";
+                break;
+            case ERR:
+                pendingBuffer += "[ERR] ";
+                break;
+            case CRIT:
+                pendingBuffer += "[CRITICAL] ";
+                break;
+            default:
+                break;
+        }
 
-    ofs << outputStr << "\n";
+        if ((long unsigned int)logLen < sizeof buf) {
+            pendingBuffer.append(buf, logLen);
+        } else {
+            // too long for the stack buffer, format it again straight into the pending one
+            const auto OLDLEN = pendingBuffer.length();
+            pendingBuffer.resize(OLDLEN + logLen + 1);
 
-    ofs.close();
+            va_start(args, fmt);
+            vsnprintf(pendingBuffer.data() + OLDLEN, logLen + 1U, fmt, args);
+            va_end(args);
 
-    // log it to the stdout too.
-    std::cout << outputStr << "\n";
+            pendingBuffer.resize(OLDLEN + logLen);
+        }
+
+        pendingBuffer += '\n';
+
+        // errors go out right away, the next thing might be a crash (which flushes on its own, see onCrashSignal)
+        if (level >= ERR)
+            flushRequested = true;
+
+        wakeUp = flushRequested || pendingBuffer.length() >= LOG_FLUSH_THRESHOLD;
+    }
 
-    // free the log
-    free(outputStr);
+    if (wakeUp)
+        bufferCV.notify_one();
 }
@@ -3,6 +3,12 @@
 
 #define LOGMESSAGESIZE 1024
 
+// anything below this level is dropped before it's formatted, e.g. -DMINLOGLEVEL=1 to drop LOG.
+// The call and its arguments stay, so don't compute anything expensive just to log it.
+#ifndef MINLOGLEVEL
+#define MINLOGLEVEL 0
+#endif
+
 enum LogLevel {
     NONE = -1,
     LOG = 0,
@@ -13,7 +19,20 @@ enum LogLevel {
 
 namespace Debug {
     void init(std::string IS);
-    void log(LogLevel level, const char* fmt, ...);
+
+    // formats into a memory buffer, the writing happens on the log thread. ERR and CRIT wake it up right away.
+    void logImpl(LogLevel level, const char* fmt, ...);
+
+    template <typename... Args>
+    inline void log(LogLevel level, const char* fmt, Args... args) {
+        if (level < MINLOGLEVEL)
+            return;
+
+        logImpl(level, fmt, args...);
+    }
+
+    // writes out everything logged so far, blocking. For crashes and exits.
+    void flush();
 
     inline std::string logFile;
-};
\ No newline at end of file
+};
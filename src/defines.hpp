@@ -47,6 +47,7 @@
 #define RASSERT(expr, reason, ...)                                                                                                                                                                                                                                                                                                                  \
     if (!(expr)) {                                                                                                                                                                                                                                                                                                                               \
         Debug::log(CRIT, "\n==========================================================================================\nASSERTION FAILED! \n\n%s\n\nat: line %d in %s", getFormat(reason, ##__VA_ARGS__).c_str(), __LINE__, ([]() constexpr->std::string { return std::string(__FILE__).substr(std::string(__FILE__).find_last_of('/') + 1); })().c_str()); \
+        Debug::flush();                                                                                                                                                                                                                                                                                                                           \
         printf("Assertion failed! See the log in /tmp/hypr/hyprland.log for more info.");                                                                                                                                                                                                                                                         \
         *((int*)nullptr) = 1;  /* so that we crash and get a coredump */                                                                                                                                                                                                                                                                  \
     }
@@ -206,6 +206,9 @@ void Events::listener_commitLayerSurface(void* owner, void* data) {
 
     layersurface->position = Vector2D(layersurface->geometry.x, layersurface->geometry.y);
 
+    if (layersurface->layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || layersurface->layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+        g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
+
     // TODO: optimize this. This does NOT need to be here but it prevents some issues with full DT.
     g_pHyprRenderer->damageMonitor(PMONITOR);
 }
\ No newline at end of file
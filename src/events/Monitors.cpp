@@ -3,7 +3,6 @@
 #include "../managers/input/InputManager.hpp"
 #include "../render/Renderer.hpp"
 #include "Events.hpp"
-#include "../debug/HyprCtl.hpp"
 
 // --------------------------------------------------------- //
 //   __  __  ____  _   _ _____ _______ ____  _____   _____   //
@@ -91,10 +90,12 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
     newMonitor.refreshRate = monitorRule.refreshRate;
 
     g_pCompositor->m_lMonitors.push_back(newMonitor);
+    g_pCompositor->invalidateMonitorIndex();
     const auto PNEWMONITOR = &g_pCompositor->m_lMonitors.back();
 
     PNEWMONITOR->hyprListener_monitorFrame.initCallback(&OUTPUT->events.frame, &Events::listener_monitorFrame, PNEWMONITOR);
     PNEWMONITOR->hyprListener_monitorDestroy.initCallback(&OUTPUT->events.destroy, &Events::listener_monitorDestroy, PNEWMONITOR);
+    PNEWMONITOR->hyprListener_monitorPresent.initCallback(&OUTPUT->events.present, &Events::listener_monitorPresent, PNEWMONITOR);
 
     wlr_output_enable(OUTPUT, 1);
 
@@ -134,6 +135,7 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
         wlr_ext_workspace_handle_v1_set_name(PNEWWORKSPACE->m_pWlrHandle, std::to_string(WORKSPACEID).c_str());
 
         PNEWWORKSPACE->m_iID = WORKSPACEID;
+        g_pCompositor->invalidateWorkspaceIndex();
         PNEWWORKSPACE->m_szName = std::to_string(WORKSPACEID);
     }
 
@@ -156,6 +158,31 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
     g_pCompositor->m_bReadyToProcess = true;
 }
 
+// the refresh interval the output reports, else the one from the mode. Modes and rules can say 0Hz, assume 60 then.
+int64_t refreshIntervalNs(SMonitor* pMonitor) {
+    if (pMonitor->presentationRefreshNs > 0)
+        return pMonitor->presentationRefreshNs;
+
+    return (int64_t)(1000000000.0 / (pMonitor->refreshRate >= 1.f ? pMonitor->refreshRate : 60.f));
+}
+
+// when the frame we're about to render will hit the screen, from the last presentation and the refresh interval
+std::chrono::steady_clock::time_point predictNextPresentation(SMonitor* pMonitor) {
+    const auto NOW = std::chrono::steady_clock::now();
+    const auto REFRESH = std::chrono::nanoseconds(refreshIntervalNs(pMonitor));
+
+    // no (recent) feedback, assume a vblank from now
+    if (pMonitor->lastPresentation.time_since_epoch().count() == 0 || NOW - pMonitor->lastPresentation > std::chrono::seconds(1))
+        return NOW + REFRESH;
+
+    auto next = pMonitor->lastPresentation + REFRESH;
+
+    if (next <= NOW)
+        next += REFRESH * ((NOW - next) / REFRESH + 1);
+
+    return next;
+}
+
 void Events::listener_monitorFrame(void* owner, void* data) {
     SMonitor* const PMONITOR = (SMonitor*)owner;
 
@@ -171,15 +198,27 @@ void Events::listener_monitorFrame(void* owner, void* data) {
         g_pDebugOverlay->frameData(PMONITOR);
     }
 
+    // how long the frame spends where, for the debug overlay
+    SFrameStageTimes stageTimes;
+    auto stageStart = std::chrono::high_resolution_clock::now();
+    const auto ENDSTAGE = [&](float& stageMs) {
+        const auto NOW = std::chrono::high_resolution_clock::now();
+        stageMs += std::chrono::duration_cast<std::chrono::nanoseconds>(NOW - stageStart).count() / 1000000.f;
+        stageStart = NOW;
+    };
+
+    // animations run at every monitor's own rate, for the moment this frame will be shown
+    PMONITOR->predictedPresentation = predictNextPresentation(PMONITOR);
+    g_pAnimationManager->tick(PMONITOR, PMONITOR->predictedPresentation);
+
+    ENDSTAGE(stageTimes.animations);
+
     // Hack: only check when monitor with top hz refreshes, saves a bit of resources.
     // This is for stuff that should be run every frame
     if (PMONITOR->ID == pMostHzMonitor->ID) {
         g_pCompositor->sanityCheckWorkspaces();
-        g_pAnimationManager->tick();
         g_pCompositor->cleanupFadingOut();
 
-        HyprCtl::tickHyprCtl(); // so that we dont get that race condition multithread bullshit
-
         g_pConfigManager->dispatchExecOnce(); // We exec-once when at least one monitor starts refreshing, meaning stuff has init'd
 
         if (g_pConfigManager->m_bWantsMonitorReload)
@@ -201,6 +240,22 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
+    stageStart = std::chrono::high_resolution_clock::now();
+
+    // hand out everything damaged since the last frame of any monitor
+    g_pHyprRenderer->flushDamage();
+
+    // what's drawn this frame, everything below works off of it
+    g_pHyprRenderer->prepareRenderList(PMONITOR);
+
+    ENDSTAGE(stageTimes.prepare);
+
+    // a lone opaque fullscreen window goes to the output as is, no compositing
+    if (g_pHyprRenderer->attemptDirectScanout(PMONITOR, &now)) {
+        wlr_output_schedule_frame(PMONITOR->output);
+        return;
+    }
+
     // check the damage
     pixman_region32_t damage;
     bool hasChanged;
@@ -223,39 +278,45 @@ void Events::listener_monitorFrame(void* owner, void* data) {
         return;
     }
 
+    // not a part of any stage, this can wait on the buffer
+    stageStart = std::chrono::high_resolution_clock::now();
+
     // if we have no tracking or full tracking, invalidate the entire monitor
-    if (*PDAMAGETRACKINGMODE == DAMAGE_TRACKING_NONE || *PDAMAGETRACKINGMODE == DAMAGE_TRACKING_MONITOR) {
+    if (*PDAMAGETRACKINGMODE == DAMAGE_TRACKING_NONE || *PDAMAGETRACKINGMODE == DAMAGE_TRACKING_MONITOR)
         pixman_region32_union_rect(&damage, &damage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
 
-        pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
-    } else {
-        static auto* const PBLURENABLED = &g_pConfigManager->getConfigValuePtr("decoration:blur")->intValue;
-
-        // if we use blur we need to expand the damage for proper blurring
-        if (*PBLURENABLED == 1) {
-            // TODO: can this be optimized?
-            static auto* const PBLURSIZE = &g_pConfigManager->getConfigValuePtr("decoration:blur_size")->intValue;
-            static auto* const PBLURPASSES = &g_pConfigManager->getConfigValuePtr("decoration:blur_passes")->intValue;
-            const auto BLURRADIUS = *PBLURSIZE * pow(2, *PBLURPASSES);  // is this 2^pass? I don't know but it works... I think.
+    pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
 
-            pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
-
-            // now, prep the damage, get the extended damage region
-            wlr_region_expand(&damage, &damage, BLURRADIUS);                                                   // expand for proper blurring
-        } else {
-            pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
-        }
-    }
+    // blur expansion and occlusion go to the worker pool, the framebuffers get bound meanwhile
+    g_pHyprRenderer->beginFramePrep(PMONITOR, &damage, *PDAMAGETRACKINGMODE == DAMAGE_TRACKING_FULL);
 
     // TODO: this is getting called with extents being 0,0,0,0 should it be?
     // potentially can save on resources.
 
+    ENDSTAGE(stageTimes.prepare);
+
     g_pHyprOpenGL->begin(PMONITOR, &damage);
+
+    ENDSTAGE(stageTimes.render);
+
+    // the damage is only final from here on, begin() just keeps the pointer
+    g_pHyprRenderer->finishFramePrep(PMONITOR, &damage);
+
+    ENDSTAGE(stageTimes.prepare);
+
+    const auto PCLEARDAMAGE = g_pHyprRenderer->getOccludedDamage(PMONITOR);
+    if (PCLEARDAMAGE)
+        g_pHyprOpenGL->m_RenderData.pDamage = PCLEARDAMAGE;
+
     g_pHyprOpenGL->clear(CColor(100, 11, 11, 255));
     g_pHyprOpenGL->clearWithTex(); // will apply the hypr "wallpaper"
 
+    g_pHyprOpenGL->m_RenderData.pDamage = &damage;
+
     g_pHyprRenderer->renderAllClientsForMonitor(PMONITOR->ID, &now);
 
+    g_pHyprRenderer->clearOcclusion();
+
     // if correct monitor draw hyprerror
     if (PMONITOR->ID == 0)
         g_pHyprError->draw();
@@ -275,6 +336,8 @@ void Events::listener_monitorFrame(void* owner, void* data) {
 
     g_pHyprOpenGL->end();
 
+    ENDSTAGE(stageTimes.render);
+
     // calc frame damage
     pixman_region32_t frameDamage;
     pixman_region32_init(&frameDamage);
@@ -289,13 +352,17 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     pixman_region32_fini(&frameDamage);
     pixman_region32_fini(&damage);
 
-    wlr_output_commit(PMONITOR->output);
+    PMONITOR->awaitingPresentation = wlr_output_commit(PMONITOR->output);
 
     wlr_output_schedule_frame(PMONITOR->output);
 
+    ENDSTAGE(stageTimes.commit);
+
     if (*PDEBUGOVERLAY == 1) {
         const float µs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startRender).count() / 1000.f;
         g_pDebugOverlay->renderData(PMONITOR, µs);
+        g_pDebugOverlay->frameStats(PMONITOR, g_pHyprOpenGL->m_sFrameStats);
+        g_pDebugOverlay->frameStageTimes(PMONITOR, stageTimes);
         if (PMONITOR->ID == 0) {
             const float µsNoOverlay = µs - std::chrono::duration_cast<std::chrono::nanoseconds>(endRenderOverlay - startRenderOverlay).count() / 1000.f;
             g_pDebugOverlay->renderDataNoOverlay(PMONITOR, µsNoOverlay);
@@ -305,6 +372,36 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     }
 }
 
+void Events::listener_monitorPresent(void* owner, void* data) {
+    const auto PMONITOR = (SMonitor*)owner;
+    const auto E = (wlr_output_event_present*)data;
+
+    if (!E->presented || !E->when)
+        return;
+
+    const auto WHEN = std::chrono::steady_clock::time_point(std::chrono::seconds(E->when->tv_sec) + std::chrono::nanoseconds(E->when->tv_nsec));
+
+    if (E->refresh > 0)
+        PMONITOR->presentationRefreshNs = E->refresh;
+
+    PMONITOR->lastPresentation = WHEN;
+
+    if (!PMONITOR->awaitingPresentation)
+        return;
+
+    PMONITOR->awaitingPresentation = false;
+
+    static auto *const PDEBUGOVERLAY = &g_pConfigManager->getConfigValuePtr("debug:overlay")->intValue;
+
+    if (*PDEBUGOVERLAY == 1) {
+        // positive = later than what the frame was animated for
+        const float ERRORMS = std::chrono::duration<float, std::milli>(WHEN - PMONITOR->predictedPresentation).count();
+        const float REFRESHMS = refreshIntervalNs(PMONITOR) / 1000000.f;
+
+        g_pDebugOverlay->framePacing(PMONITOR, ERRORMS, ERRORMS > REFRESHMS / 2.f);
+    }
+}
+
 void Events::listener_monitorDestroy(void* owner, void* data) {
     const auto OUTPUT = (wlr_output*)data;
 
@@ -353,6 +450,7 @@ void Events::listener_monitorDestroy(void* owner, void* data) {
     for (auto it = g_pCompositor->m_lWorkspaces.begin(); it != g_pCompositor->m_lWorkspaces.end(); ++it) {
         if (it->m_iMonitorID == pMonitor->ID) {
             it = g_pCompositor->m_lWorkspaces.erase(it);
+            g_pCompositor->invalidateWorkspaceIndex();
         }
     }
 
@@ -361,6 +459,7 @@ void Events::listener_monitorDestroy(void* owner, void* data) {
     g_pEventManager->postEvent(SHyprIPCEvent("monitorremoved", pMonitor->szName));
 
     g_pCompositor->m_lMonitors.remove(*pMonitor);
+    g_pCompositor->invalidateMonitorIndex();
 
     // update the pMostHzMonitor
     if (pMostHzMonitor == pMonitor) {
@@ -30,6 +30,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
     PWINDOW->m_bMappedX11 = true;
     PWINDOW->m_iWorkspaceID = PMONITOR->specialWorkspaceOpen ? SPECIAL_WORKSPACE_ID : PMONITOR->activeWorkspace;
     PWINDOW->m_bIsMapped = true;
+    g_pCompositor->invalidateWindowIndex();
     PWINDOW->m_bReadyToDelete = false;
     PWINDOW->m_bFadingOut = false;
     PWINDOW->m_szTitle = g_pXWaylandManager->getTitle(PWINDOW);
@@ -50,6 +51,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
 
     if (!PWINDOWSURFACE) {
         g_pCompositor->m_lWindows.remove(*PWINDOW);
+        g_pCompositor->invalidateWindowIndex();
         return;
     }
 
@@ -95,6 +97,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
                 }
 
                 PWINDOW->m_iWorkspaceID = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID)->activeWorkspace;
+                g_pCompositor->invalidateWindowIndex();
 
                 Debug::log(ERR, "Rule monitor, applying to window %x -> mon: %i, workspace: %i", PWINDOW, PWINDOW->m_iMonitorID, PWINDOW->m_iWorkspaceID);
             } catch (std::exception& e) {
@@ -161,6 +164,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
 
             PWINDOW->m_iMonitorID = g_pCompositor->m_pLastMonitor->ID;
             PWINDOW->m_iWorkspaceID = g_pCompositor->m_pLastMonitor->activeWorkspace;
+            g_pCompositor->invalidateWindowIndex();
         }
     }
 
@@ -290,6 +294,7 @@ void Events::listener_unmapWindow(void* owner, void* data) {
 
     // do this after onWindowRemoved because otherwise it'll think the window is invalid
     PWINDOW->m_bIsMapped = false;
+    g_pCompositor->invalidateWindowIndex(); // an X11 window's surface goes away after this
 
     // refocus on a new window
     g_pInputManager->refocus();
@@ -441,6 +446,7 @@ void Events::listener_surfaceXWayland(wl_listener* listener, void* data) {
     Debug::log(LOG, "New XWayland Surface created.");
 
     g_pCompositor->m_lWindows.emplace_back();
+    g_pCompositor->invalidateWindowIndex();
     const auto PNEWWINDOW = &g_pCompositor->m_lWindows.back();
 
     PNEWWINDOW->m_uSurface.xwayland = XWSURFACE;
@@ -462,6 +468,7 @@ void Events::listener_newXDGSurface(wl_listener* listener, void* data) {
         return;  // TODO: handle?
 
     g_pCompositor->m_lWindows.emplace_back();
+    g_pCompositor->invalidateWindowIndex();
     const auto PNEWWINDOW = &g_pCompositor->m_lWindows.back();
     PNEWWINDOW->m_uSurface.xdg = XDGSURFACE;
 
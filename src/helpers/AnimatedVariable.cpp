@@ -13,8 +13,6 @@ void CAnimatedVariable::create(ANIMATEDVARTYPE type, float* speed, int64_t* enab
     m_pWindow = pWindow;
     m_pBezier = pBezier;
 
-    g_pAnimationManager->m_lAnimatedVariables.push_back(this);
-
     m_bDummy = false;
 }
 
@@ -56,5 +54,17 @@ CAnimatedVariable::~CAnimatedVariable() {
 }
 
 void CAnimatedVariable::unregister() {
-    g_pAnimationManager->m_lAnimatedVariables.remove(this);
+    if (g_pAnimationManager)
+        g_pAnimationManager->unscheduleAnimation(this);
+}
+
+void CAnimatedVariable::onAnimationBegin() {
+    animationBegin = std::chrono::steady_clock::now();
+
+    if (m_bDummy) {
+        Debug::log(ERR, "CAnimatedVariable %x got a new value before create(), it won't animate", this);
+        return;
+    }
+
+    g_pAnimationManager->scheduleAnimation(this);
 }
\ No newline at end of file
@@ -17,6 +17,7 @@ enum AVARDAMAGEPOLICY {
 };
 
 class CAnimationManager;
+class CBezierCurve;
 class CWorkspace;
 struct SLayerSurface;
 
@@ -29,6 +30,10 @@ public:
 
     ~CAnimatedVariable();
 
+    // the animation manager's active set holds vars by address, a copy would carry over a slot that isn't its own
+    CAnimatedVariable(const CAnimatedVariable&) = delete;
+    CAnimatedVariable& operator=(const CAnimatedVariable&) = delete;
+
     void unregister();
 
     // gets the current vector value (real time)
@@ -70,21 +75,21 @@ public:
     void operator=(const Vector2D& v) {
         RASSERT(m_eVarType == AVARTYPE_VECTOR, "Tried to access =v of AVARTYPE %i!", m_eVarType);
         m_vGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        onAnimationBegin();
         m_vBegun = m_vValue;
     }
 
     void operator=(const float& v) {
         RASSERT(m_eVarType == AVARTYPE_FLOAT, "Tried to access =f of AVARTYPE %i!", m_eVarType);
         m_fGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        onAnimationBegin();
         m_fBegun = m_fValue;
     }
 
     void operator=(const CColor& v) {
         RASSERT(m_eVarType == AVARTYPE_COLOR, "Tried to access =c of AVARTYPE %i!", m_eVarType);
         m_cGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        onAnimationBegin();
         m_cBegun = m_cValue;
     }
 
@@ -92,7 +97,7 @@ public:
     void setValue(const Vector2D& v) {
         RASSERT(m_eVarType == AVARTYPE_VECTOR, "Tried to access setValue(v) of AVARTYPE %i!", m_eVarType);
         m_vValue = v;
-        animationBegin = std::chrono::system_clock::now();
+        onAnimationBegin();
         m_vBegun = m_vValue;
     }
 
@@ -100,16 +105,16 @@ public:
     void setValue(const float& v) {
         RASSERT(m_eVarType == AVARTYPE_FLOAT, "Tried to access setValue(f) of AVARTYPE %i!", m_eVarType);
         m_fValue = v;
-        animationBegin = std::chrono::system_clock::now();
-        m_vBegun = m_vValue;
+        onAnimationBegin();
+        m_fBegun = m_fValue;
     }
 
     // Sets the actual stored value, without affecting the goal, but resets the timer
     void setValue(const CColor& v) {
         RASSERT(m_eVarType == AVARTYPE_COLOR, "Tried to access setValue(c) of AVARTYPE %i!", m_eVarType);
         m_cValue = v;
-        animationBegin = std::chrono::system_clock::now();
-        m_vBegun = m_vValue;
+        onAnimationBegin();
+        m_cBegun = m_cValue;
     }
 
     // Sets the actual value and goal
@@ -170,6 +175,9 @@ public:
 
 private:
 
+    // resets the timer and puts us in the animation manager's active set
+    void            onAnimationBegin();
+
     Vector2D        m_vValue = Vector2D(0,0);
     float           m_fValue = 0;
     CColor          m_cValue;
@@ -192,9 +200,16 @@ private:
 
     std::string*    m_pBezier = nullptr;
 
+    // resolved from m_pBezier when the animation starts, re-resolved when the beziers get reloaded
+    CBezierCurve*   m_pResolvedBezier = nullptr;
+    size_t          m_iBezierGeneration = 0;
+
+    // position in the animation manager's active set, -1 when idle
+    int             m_iActiveIndex = -1;
+
     bool            m_bDummy = true;
 
-    std::chrono::system_clock::time_point animationBegin;
+    std::chrono::steady_clock::time_point animationBegin;
 
     ANIMATEDVARTYPE     m_eVarType      = AVARTYPE_INVALID;
     AVARDAMAGEPOLICY    m_eDamagePolicy = AVARDAMAGE_INVALID;
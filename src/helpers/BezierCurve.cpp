@@ -3,8 +3,6 @@
 void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
     m_dPoints.clear();
 
-    const auto BEGIN = std::chrono::high_resolution_clock::now();
-
     m_dPoints.emplace_back(Vector2D(0,0));
 
     for (auto& p : *pVec) {
@@ -15,58 +13,67 @@ void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
 
     RASSERT(m_dPoints.size() == 4, "CBezierCurve only supports cubic beziers! (points num: %i)", m_dPoints.size());
 
+    // expand the bernstein form once so that evaluating is just a few mul-adds
+    m_fCX = 3.f * m_dPoints[1].x;
+    m_fBX = 3.f * (m_dPoints[2].x - m_dPoints[1].x) - m_fCX;
+    m_fAX = 1.f - m_fCX - m_fBX;
+    m_fCY = 3.f * m_dPoints[1].y;
+    m_fBY = 3.f * (m_dPoints[2].y - m_dPoints[1].y) - m_fCY;
+    m_fAY = 1.f - m_fCY - m_fBY;
+
     // bake BAKEDPOINTS points for faster lookups
-    // T -> X ( / BAKEDPOINTS )
+    // T -> X ( / (BAKEDPOINTS - 1) ), including both ends
     for (int i = 0; i < BAKEDPOINTS; ++i) {
-        m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
+        const float T = i / (float)(BAKEDPOINTS - 1);
+        m_aPointsBaked[i] = Vector2D(getXForT(T), getYForT(T));
     }
-
-    const auto ELAPSEDUS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / 1000.f;
-    const auto POINTSSIZE = m_aPointsBaked.size() * sizeof(m_aPointsBaked[0]) / 1000.f;
-
-    const auto BEGINCALC = std::chrono::high_resolution_clock::now();
-    for (float i = 0.1f; i < 1.f; i += 0.1f)
-        getYForPoint(i);
-    const auto ELAPSEDCALCAVG = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGINCALC).count() / 1000.f / 10.f;
-
-    Debug::log(LOG, "Created a bezier curve, baked %i points, mem usage: %.2fkB, time to bake: %.2fµs. Estimated average calc time: %.2fµs.",
-        BAKEDPOINTS, POINTSSIZE, ELAPSEDUS, ELAPSEDCALCAVG);
-
 }
 
 float CBezierCurve::getYForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].y + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].y + pow(t, 3);
+    return ((m_fAY * t + m_fBY) * t + m_fCY) * t;
 }
 
 float CBezierCurve::getXForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].x + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].x + pow(t, 3);
+    return ((m_fAX * t + m_fBX) * t + m_fCX) * t;
+}
+
+float CBezierCurve::getXSlopeForT(float t) {
+    return (3.f * m_fAX * t + 2.f * m_fBX) * t + m_fCX;
 }
 
-// Todo: this probably can be done better and faster
 float CBezierCurve::getYForPoint(float x) {
-    // binary search for the range UPDOWN X
-    float upperT = 1;
-    float lowerT = 0;
-    float mid = 0.5;
-
-    while(std::abs(upperT - lowerT) > INVBAKEDPOINTS) {
-        if (m_aPointsBaked[((int)(mid * (float)BAKEDPOINTS))].x > x) {
-            upperT = mid;
-        } else {
-            lowerT = mid;
-        }
-
-        mid = (upperT + lowerT) / 2.f;
-    }
+    if (x <= 0.f)
+        return 0.f;
+    if (x >= 1.f)
+        return 1.f;
 
-    // in the name of performance i shall make a hack
-    const auto LOWERPOINT = &m_aPointsBaked[std::clamp((int)((float)BAKEDPOINTS * lowerT), 0, 199)];
-    const auto UPPERPOINT = &m_aPointsBaked[std::clamp((int)((float)BAKEDPOINTS * upperT), 0, 199)];
+    // find the baked segment x is in
+    const auto UPPER = std::lower_bound(m_aPointsBaked.begin(), m_aPointsBaked.end(), x, [](const Vector2D& point, float x) { return point.x < x; });
+    const int UPPERINDEX = std::clamp((int)(UPPER - m_aPointsBaked.begin()), 1, BAKEDPOINTS - 1);
 
-    const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+    const auto& LOWERPOINT = m_aPointsBaked[UPPERINDEX - 1];
+    const auto& UPPERPOINT = m_aPointsBaked[UPPERINDEX];
 
-    if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA))  // can sometimes happen for VERY small x
-        return 0.f;
+    const float LOWERT = (UPPERINDEX - 1) / (float)(BAKEDPOINTS - 1);
+    const float UPPERT = UPPERINDEX / (float)(BAKEDPOINTS - 1);
+
+    // interpolate a first guess for t, then let newton take it the rest of the way
+    const float DELTAX = UPPERPOINT.x - LOWERPOINT.x;
+    float t = DELTAX > 0 ? LOWERT + (UPPERT - LOWERT) * std::clamp((float)((x - LOWERPOINT.x) / DELTAX), 0.f, 1.f) : LOWERT;
+
+    for (int i = 0; i < NEWTONITERATIONS; ++i) {
+        const float ERROR = getXForT(t) - x;
+
+        if (std::abs(ERROR) < NEWTONEPSILON)
+            break;
+
+        const float SLOPE = getXSlopeForT(t);
 
-    return LOWERPOINT->y + (UPPERPOINT->y - UPPERPOINT->y) * PERCINDELTA;
-}
\ No newline at end of file
+        if (std::abs(SLOPE) < 1e-6f)
+            break; // flat, the guess is as good as it gets
+
+        t = std::clamp(t - ERROR / SLOPE, LOWERT, UPPERT);
+    }
+
+    return getYForT(t);
+}
@@ -4,7 +4,10 @@
 #include <deque>
 
 constexpr int BAKEDPOINTS = 200;
-constexpr float INVBAKEDPOINTS = 1.f / BAKEDPOINTS;
+
+// refinement of the baked guess, stops early once within NEWTONEPSILON (well below a pixel)
+constexpr int NEWTONITERATIONS = 4;
+constexpr float NEWTONEPSILON = 1e-7f;
 
 // an implementation of a cubic bezier curve
 // might do better later
@@ -20,8 +23,15 @@ public:
     float   getYForPoint(float x);
 
 private:
+    // dx/dt, for the newton steps
+    float   getXSlopeForT(float t);
+
     // this INCLUDES the 0,0 and 1,1 points.
     std::deque<Vector2D>    m_dPoints;
 
+    // polynomial coefficients, x(t) = ((ax * t + bx) * t + cx) * t, same for y
+    float   m_fAX = 0, m_fBX = 0, m_fCX = 0;
+    float   m_fAY = 0, m_fBY = 0, m_fCY = 0;
+
     std::array<Vector2D, BAKEDPOINTS>  m_aPointsBaked;
 };
\ No newline at end of file
@@ -142,27 +142,51 @@ bool isDirection(const std::string& arg) {
     return arg == "l" || arg == "r" || arg == "u" || arg == "d" || arg == "t" || arg == "b";
 }
 
-int getWorkspaceIDFromString(const std::string& in, std::string& outName) {
-    int result = INT_MAX;
+SWorkspaceTarget parseWorkspaceTarget(const std::string& in) {
+    SWorkspaceTarget target;
+
     if (in.find("special") == 0) {
-        outName = "special";
-        return SPECIAL_WORKSPACE_ID;
+        target.type = SWorkspaceTarget::SPECIAL;
     } else if (in.find("name:") == 0) {
-        const auto WORKSPACENAME = in.substr(in.find_first_of(':') + 1);
-        const auto WORKSPACE = g_pCompositor->getWorkspaceByName(WORKSPACENAME);
-        if (!WORKSPACE) {
-            result = g_pCompositor->getNextAvailableNamedWorkspace();
-        } else {
-            result = WORKSPACE->m_iID;
-        }
-        outName = WORKSPACENAME;
+        target.type = SWorkspaceTarget::NAMED;
+        target.name = in.substr(in.find_first_of(':') + 1);
+    } else if (in[0] == 'm') {
+        target.value = getPlusMinusKeywordResult(in.substr(1), 0);
+        target.type = target.value == INT_MAX ? SWorkspaceTarget::INVALID : SWorkspaceTarget::MONITOR_RELATIVE;
     } else {
-        if (in[0] == 'm') {
-            // monitor relative
-            result = (int)getPlusMinusKeywordResult(in.substr(1), 0);
+        target.value = getPlusMinusKeywordResult(in, 0);
+
+        if (target.value == INT_MAX)
+            target.type = SWorkspaceTarget::INVALID;
+        else if (in[0] == '+' || in[0] == '-')
+            target.type = SWorkspaceTarget::RELATIVE;
+        else
+            target.type = SWorkspaceTarget::ABSOLUTE;
+    }
+
+    return target;
+}
+
+int getWorkspaceIDFromTarget(const SWorkspaceTarget& target, std::string& outName) {
+    int result = INT_MAX;
 
-            // result now has +/- what we should move on mon
-            int remains = (int)result;
+    switch (target.type) {
+        case SWorkspaceTarget::SPECIAL:
+            outName = "special";
+            return SPECIAL_WORKSPACE_ID;
+        case SWorkspaceTarget::NAMED: {
+            const auto WORKSPACE = g_pCompositor->getWorkspaceByName(target.name);
+            if (!WORKSPACE) {
+                result = g_pCompositor->getNextAvailableNamedWorkspace();
+            } else {
+                result = WORKSPACE->m_iID;
+            }
+            outName = target.name;
+            break;
+        }
+        case SWorkspaceTarget::MONITOR_RELATIVE: {
+            // value has +/- what we should move on mon
+            int remains = (int)target.value;
             int currentID = g_pCompositor->m_pLastMonitor->activeWorkspace;
             int searchID = currentID;
 
@@ -205,16 +229,27 @@ int getWorkspaceIDFromString(const std::string& in, std::string& outName) {
 
             result = currentID;
             outName = g_pCompositor->getWorkspaceByID(currentID)->m_szName;
-
-        } else {
-            result = std::clamp((int)getPlusMinusKeywordResult(in, g_pCompositor->m_pLastMonitor->activeWorkspace), 1, INT_MAX);
+            break;
+        }
+        case SWorkspaceTarget::RELATIVE:
+            result = std::clamp((int)(g_pCompositor->m_pLastMonitor->activeWorkspace + target.value), 1, INT_MAX);
             outName = std::to_string(result);
-        }        
+            break;
+        case SWorkspaceTarget::ABSOLUTE:
+            result = std::clamp((int)target.value, 1, INT_MAX);
+            outName = std::to_string(result);
+            break;
+        case SWorkspaceTarget::INVALID:
+            break;
     }
 
     return result;
 }
 
+int getWorkspaceIDFromString(const std::string& in, std::string& outName) {
+    return getWorkspaceIDFromTarget(parseWorkspaceTarget(in), outName);
+}
+
 float vecToRectDistanceSquared(const Vector2D& vec, const Vector2D& p1, const Vector2D& p2) {
     const float DX = std::max((double)0, std::max(p1.x - vec.x, vec.x - p2.x));
     const float DY = std::max((double)0, std::max(p1.y - vec.y, vec.y - p2.y));
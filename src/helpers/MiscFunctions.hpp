@@ -9,6 +9,24 @@ void scaleBox(wlr_box*, float);
 std::string removeBeginEndSpacesTabs(std::string);
 bool isNumber(const std::string&);
 bool isDirection(const std::string&);
+
+// a workspace argument ("3", "+1", "m-1", "name:foo", "special") parsed once, resolved against the current state later
+struct SWorkspaceTarget {
+    enum eType {
+        INVALID = 0,
+        ABSOLUTE,
+        RELATIVE,
+        MONITOR_RELATIVE,
+        NAMED,
+        SPECIAL
+    } type = INVALID;
+
+    float       value = 0;
+    std::string name = "";
+};
+
+SWorkspaceTarget parseWorkspaceTarget(const std::string&);
+int getWorkspaceIDFromTarget(const SWorkspaceTarget&, std::string&);
 int getWorkspaceIDFromString(const std::string&, std::string&);
 float vecToRectDistanceSquared(const Vector2D& vec, const Vector2D& p1, const Vector2D& p2);
 
@@ -5,6 +5,7 @@
 #include "WLClasses.hpp"
 #include <list>
 #include <array>
+#include "../render/Scanout.hpp"
 
 struct SMonitor {
     Vector2D    vecPosition         = Vector2D(0,0);
@@ -31,6 +32,15 @@ struct SMonitor {
     bool        noFrameSchedule = false;
     wl_output_transform transform = WL_OUTPUT_TRANSFORM_NORMAL;
 
+    // frame pacing, fed by the output's present events
+    std::chrono::steady_clock::time_point lastPresentation;
+    int         presentationRefreshNs = 0;  // 0 if the backend doesn't tell us
+    std::chrono::steady_clock::time_point predictedPresentation; // what the last rendered frame was animated for
+    bool        awaitingPresentation = false;
+
+    // of the last frame, SCANOUT_OK if it was scanned out directly
+    eScanoutFallback scanoutFallback = SCANOUT_NO_FULLSCREEN;
+
     // for the special workspace
     bool        specialWorkspaceOpen = false;
     
@@ -42,6 +52,7 @@ struct SMonitor {
     DYNLISTENER(monitorFrame);
     DYNLISTENER(monitorDestroy);
     DYNLISTENER(monitorMode);
+    DYNLISTENER(monitorPresent);
 
     // hack: a group = workspaces on a monitor.
     // I don't really care lol :P
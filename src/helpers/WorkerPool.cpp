@@ -0,0 +1,82 @@
+#include "WorkerPool.hpp"
+
+CWorkerPool::CWorkerPool(size_t threads) {
+    for (size_t i = 0; i < threads; ++i)
+        m_vThreads.emplace_back([this]() { workerMain(); });
+}
+
+CWorkerPool::~CWorkerPool() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lg(m_mJobMutex);
+        m_bStop = true;
+    }
+
+    m_cvWork.notify_all();
+
+    for (auto& t : m_vThreads)
+        t.join();
+}
+
+size_t CWorkerPool::threads() const {
+    return m_vThreads.size();
+}
+
+void CWorkerPool::dispatch(size_t count, std::function<void(size_t)> fn) {
+    // the last job's tasks might still be using m_fJob
+    wait();
+
+    if (count == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lg(m_mJobMutex);
+        m_fJob = std::move(fn);
+        m_iNextTask = 0;
+        m_iTaskCount = count;
+        m_iTasksLeft = count;
+    }
+
+    m_cvWork.notify_all();
+}
+
+bool CWorkerPool::runNextTask(std::unique_lock<std::mutex>& lock) {
+    if (m_iNextTask >= m_iTaskCount)
+        return false;
+
+    const auto TASK = m_iNextTask++;
+
+    lock.unlock();
+    m_fJob(TASK);
+    lock.lock();
+
+    if (--m_iTasksLeft == 0)
+        m_cvDone.notify_all();
+
+    return true;
+}
+
+void CWorkerPool::wait() {
+    std::unique_lock<std::mutex> lock(m_mJobMutex);
+
+    // no point in idling while there's work, and with no workers (one core) this is what runs the job
+    while (runNextTask(lock)) {
+        ;
+    }
+
+    m_cvDone.wait(lock, [this]() { return m_iTasksLeft == 0; });
+}
+
+void CWorkerPool::workerMain() {
+    std::unique_lock<std::mutex> lock(m_mJobMutex);
+
+    while (true) {
+        m_cvWork.wait(lock, [this]() { return m_bStop || m_iNextTask < m_iTaskCount; });
+
+        if (m_bStop)
+            return;
+
+        runNextTask(lock);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A few threads for work the main thread hands out and then waits for, like a frame's region math.
+// One job at a time: dispatch() runs fn(i) for every i < count on the workers and returns right away, wait() helps
+// with what's left and returns once all of it is done. Only ever dispatch from one thread.
+class CWorkerPool {
+public:
+    CWorkerPool(size_t threads);
+    ~CWorkerPool();
+
+    CWorkerPool(const CWorkerPool&) = delete;
+    CWorkerPool& operator=(const CWorkerPool&) = delete;
+
+    void dispatch(size_t count, std::function<void(size_t)> fn);
+    void wait();
+
+    size_t threads() const;
+
+private:
+    void                        workerMain();
+    // runs the next task of the job, false if none are left to start. Called with the lock held, returns with it held.
+    bool                        runNextTask(std::unique_lock<std::mutex>&);
+
+    std::vector<std::thread>    m_vThreads;
+
+    std::mutex                  m_mJobMutex;
+    std::condition_variable     m_cvWork;
+    std::condition_variable     m_cvDone;
+
+    std::function<void(size_t)> m_fJob;
+    size_t                      m_iNextTask = 0;
+    size_t                      m_iTaskCount = 0;
+    size_t                      m_iTasksLeft = 0; // started or not
+    bool                        m_bStop = false;
+};
@@ -13,7 +13,8 @@ CWorkspace::CWorkspace(int monitorID, bool special) {
 
     m_bIsSpecialWorkspace = special;
     
-    if (!special) {
+    // no workspace group without a real output (headless)
+    if (!special && PMONITOR->pWLRWorkspaceGroupHandle) {
         m_pWlrHandle = wlr_ext_workspace_handle_v1_create(PMONITOR->pWLRWorkspaceGroupHandle);
 
         // set geometry here cuz we can
@@ -45,7 +46,9 @@ CWorkspace::~CWorkspace() {
 }
 
 void CWorkspace::startAnim(bool in, bool left, bool instant) {
-    const auto ANIMSTYLE = g_pConfigManager->getString("animations:workspaces_style");
+    static auto *const PANIMSTYLE = &g_pConfigManager->getConfigValuePtr("animations:workspaces_style")->strValue;
+
+    const auto& ANIMSTYLE = *PANIMSTYLE;
 
     if (ANIMSTYLE == "fade") {
         m_vRenderOffset.setValueAndWarp(Vector2D(0, 0)); // fix a bug, if switching from slide -> fade.
@@ -98,7 +101,7 @@ void CWorkspace::setActive(bool on) {
 void CWorkspace::moveToMonitor(const int& id) {
     const auto PMONITOR = g_pCompositor->getMonitorFromID(id);
 
-    if (!PMONITOR || m_bIsSpecialWorkspace)
+    if (!PMONITOR || m_bIsSpecialWorkspace || !m_pWlrHandle || !PMONITOR->pWLRWorkspaceGroupHandle)
         return;
 
     wlr_ext_workspace_handle_v1_set_active(m_pWlrHandle, false);
@@ -83,6 +83,11 @@ void CHyprError::createQueued() {
     g_pHyprRenderer->damageMonitor(PMONITOR);
 }
 
+bool CHyprError::active() {
+    // anything queued needs a composited frame to happen too
+    return m_bIsCreated || m_szQueued != "" || m_bQueuedDestroy;
+}
+
 void CHyprError::draw() {
     if (!m_bIsCreated || m_szQueued != "") {
         if (m_szQueued != "")
@@ -10,6 +10,7 @@ public:
     void            queueCreate(std::string message, const CColor& color);
     void            draw();
     void            destroy();
+    bool            active();
 
 private:
     void            createQueued();
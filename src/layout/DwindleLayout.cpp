@@ -23,7 +23,9 @@ void SDwindleNodeData::recalcSizePosRecursive() {
 
         const auto REVERSESPLITRATIO = 2.f - splitRatio;
 
-        if (g_pConfigManager->getInt("dwindle:preserve_split") == 0)
+        static auto *const PPRESERVESPLIT = &g_pConfigManager->getConfigValuePtr("dwindle:preserve_split")->intValue;
+
+        if (*PPRESERVESPLIT == 0)
             splitTop = size.y > size.x;
 
         const auto SPLITSIDE = !splitTop;
@@ -58,38 +60,102 @@ void SDwindleNodeData::getAllChildrenRecursive(std::deque<SDwindleNodeData*>* pD
     }
 }
 
-int CHyprDwindleLayout::getNodesOnWorkspace(const int& id) {
-    int no = 0;
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.workspaceID == id)
-            ++no;
+SDwindleNodeData* CHyprDwindleLayout::allocateNode(const int& workspaceID, CWindow* pWindow) {
+    SDwindleNodeData* PNODE = nullptr;
+
+    if (!m_vFreeNodes.empty()) {
+        PNODE = m_vFreeNodes.back();
+        m_vFreeNodes.pop_back();
+    } else {
+        PNODE = &m_dNodePool.emplace_back();
     }
-    return no;
+
+    *PNODE = SDwindleNodeData();
+    PNODE->workspaceID = workspaceID;
+    PNODE->layout = this;
+
+    auto& workspaceData = m_mWorkspaceData[workspaceID];
+    workspaceData.nodes++;
+
+    if (pWindow) {
+        PNODE->pWindow = pWindow;
+        PNODE->isNode = false;
+        PNODE->workspaceIterator = workspaceData.windowNodes.insert(workspaceData.windowNodes.end(), PNODE);
+        m_mWindowNodes[pWindow] = PNODE;
+    } else {
+        PNODE->isNode = true;
+    }
+
+    return PNODE;
+}
+
+void CHyprDwindleLayout::freeNode(SDwindleNodeData* pNode) {
+    const auto WORKSPACEDATA = m_mWorkspaceData.find(pNode->workspaceID);
+
+    if (WORKSPACEDATA != m_mWorkspaceData.end()) {
+        if (!pNode->isNode)
+            WORKSPACEDATA->second.windowNodes.erase(pNode->workspaceIterator);
+
+        if (WORKSPACEDATA->second.root == pNode)
+            WORKSPACEDATA->second.root = nullptr;
+
+        if (--WORKSPACEDATA->second.nodes <= 0)
+            m_mWorkspaceData.erase(WORKSPACEDATA);
+    }
+
+    if (!pNode->isNode) {
+        if (const auto IT = m_mWindowNodes.find(pNode->pWindow); IT != m_mWindowNodes.end() && IT->second == pNode)
+            m_mWindowNodes.erase(IT);
+    }
+
+    *pNode = SDwindleNodeData();
+    m_vFreeNodes.push_back(pNode);
+}
+
+int CHyprDwindleLayout::getNodesOnWorkspace(const int& id) {
+    const auto WORKSPACEDATA = m_mWorkspaceData.find(id);
+
+    return WORKSPACEDATA == m_mWorkspaceData.end() ? 0 : WORKSPACEDATA->second.nodes;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getFirstNodeOnWorkspace(const int& id) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.workspaceID == id && n.pWindow && g_pCompositor->windowValidMapped(n.pWindow))
-            return &n;
+    const auto WORKSPACEDATA = m_mWorkspaceData.find(id);
+
+    if (WORKSPACEDATA == m_mWorkspaceData.end())
+        return nullptr;
+
+    // practically always the first one
+    for (auto& n : WORKSPACEDATA->second.windowNodes) {
+        if (g_pCompositor->windowValidMapped(n->pWindow))
+            return n;
     }
+
     return nullptr;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getNodeFromWindow(CWindow* pWindow) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.pWindow == pWindow && !n.isNode)
-            return &n;
-    }
+    const auto IT = m_mWindowNodes.find(pWindow);
 
-    return nullptr;
+    return IT == m_mWindowNodes.end() ? nullptr : IT->second;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getMasterNodeOnWorkspace(const int& id) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (!n.pParent && n.workspaceID == id)
-            return &n;
+    const auto WORKSPACEDATA = m_mWorkspaceData.find(id);
+
+    if (WORKSPACEDATA == m_mWorkspaceData.end() || WORKSPACEDATA->second.windowNodes.empty())
+        return nullptr;
+
+    auto& root = WORKSPACEDATA->second.root;
+
+    // splits and removals can move the root, climbing from any window is O(depth)
+    if (!root || root->pParent) {
+        root = WORKSPACEDATA->second.windowNodes.front();
+
+        while (root->pParent)
+            root = root->pParent;
     }
-    return nullptr;
+
+    return root;
 }
 
 void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode) {
@@ -104,15 +170,29 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode) {
     if (pNode->isNode) 
         return;
 
+    // while batching, the boxes and animation goals are set right away so that the rest of the batch
+    // (directional focus, cursor warps) sees them, only the configure waits for onBatchEnd.
+    // (fake nodes from fullscreenRequestForWindow have no layout and apply right away)
+    const bool BATCHING = g_pCompositor->isBatching() && pNode->layout && pNode->pWindow;
+
+    if (BATCHING)
+        m_sBatchedWindows.insert(pNode->pWindow);
+    else if (!m_sBatchedWindows.empty())
+        m_sBatchedWindows.erase(pNode->pWindow);
+
     // for gaps outer
     const bool DISPLAYLEFT          = STICKS(pNode->position.x, PMONITOR->vecPosition.x + PMONITOR->vecReservedTopLeft.x);
     const bool DISPLAYRIGHT         = STICKS(pNode->position.x + pNode->size.x, PMONITOR->vecPosition.x + PMONITOR->vecSize.x - PMONITOR->vecReservedBottomRight.x);
     const bool DISPLAYTOP           = STICKS(pNode->position.y, PMONITOR->vecPosition.y + PMONITOR->vecReservedTopLeft.y);
     const bool DISPLAYBOTTOM        = STICKS(pNode->position.y + pNode->size.y, PMONITOR->vecPosition.y + PMONITOR->vecSize.y - PMONITOR->vecReservedBottomRight.y);
 
-    const auto BORDERSIZE           = g_pConfigManager->getInt("general:border_size");
-    const auto GAPSIN               = g_pConfigManager->getInt("general:gaps_in");
-    const auto GAPSOUT              = g_pConfigManager->getInt("general:gaps_out");
+    static auto *const PBORDERSIZE  = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
+    static auto *const PGAPSIN      = &g_pConfigManager->getConfigValuePtr("general:gaps_in")->intValue;
+    static auto *const PGAPSOUT     = &g_pConfigManager->getConfigValuePtr("general:gaps_out")->intValue;
+
+    const auto BORDERSIZE           = *PBORDERSIZE;
+    const auto GAPSIN               = *PGAPSIN;
+    const auto GAPSOUT              = *PGAPSOUT;
 
     const auto PWINDOW = pNode->pWindow;
 
@@ -169,12 +249,14 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode) {
         PWINDOW->m_vRealPosition = calcPos + (calcSize - calcSize * *PSCALEFACTOR) / 2.f;
         PWINDOW->m_vRealSize = calcSize * *PSCALEFACTOR;
 
-        g_pXWaylandManager->setWindowSize(PWINDOW, calcSize * *PSCALEFACTOR);
+        if (!BATCHING)
+            g_pXWaylandManager->setWindowSize(PWINDOW, calcSize * *PSCALEFACTOR);
     } else {
         PWINDOW->m_vRealSize = calcSize;
         PWINDOW->m_vRealPosition = calcPos;
 
-        g_pXWaylandManager->setWindowSize(PWINDOW, calcSize);
+        if (!BATCHING)
+            g_pXWaylandManager->setWindowSize(PWINDOW, calcSize);
     }
 }
 
@@ -182,17 +264,11 @@ void CHyprDwindleLayout::onWindowCreated(CWindow* pWindow) {
     if (pWindow->m_bIsFloating)
         return;
 
-    m_lDwindleNodesData.push_back(SDwindleNodeData());
-    const auto PNODE = &m_lDwindleNodesData.back();
+    // Populate the node with our window's data
+    const auto PNODE = allocateNode(pWindow->m_iWorkspaceID, pWindow);
 
     const auto PMONITOR = g_pCompositor->getMonitorFromID(pWindow->m_iMonitorID);
 
-    // Populate the node with our window's data
-    PNODE->workspaceID = pWindow->m_iWorkspaceID;
-    PNODE->pWindow = pWindow;
-    PNODE->isNode = false;
-    PNODE->layout = this;
-
     SDwindleNodeData* OPENINGON;
     const auto MONFROMCURSOR = g_pCompositor->getMonitorFromCursor();
 
@@ -225,22 +301,21 @@ void CHyprDwindleLayout::onWindowCreated(CWindow* pWindow) {
     
     // If it's not, get the node under our cursor
 
-    m_lDwindleNodesData.push_back(SDwindleNodeData());
-    const auto NEWPARENT = &m_lDwindleNodesData.back();
+    // it is a node
+    const auto NEWPARENT = allocateNode(OPENINGON->workspaceID, nullptr);
 
     // make the parent have the OPENINGON's stats
     NEWPARENT->position = OPENINGON->position;
     NEWPARENT->size = OPENINGON->size;
-    NEWPARENT->workspaceID = OPENINGON->workspaceID;
     NEWPARENT->pParent = OPENINGON->pParent;
-    NEWPARENT->isNode = true; // it is a node
 
     // if cursor over first child, make it first, etc
     const auto SIDEBYSIDE = NEWPARENT->size.x / NEWPARENT->size.y > 1.f;
     NEWPARENT->splitTop = !SIDEBYSIDE;
     const auto MOUSECOORDS = g_pInputManager->getMouseCoordsInternal();
 
-    const auto FORCESPLIT = g_pConfigManager->getInt("dwindle:force_split");
+    static auto *const PFORCESPLIT = &g_pConfigManager->getConfigValuePtr("dwindle:force_split")->intValue;
+    const auto FORCESPLIT = *PFORCESPLIT;
 
     if (FORCESPLIT == 0) {
         if ((SIDEBYSIDE && VECINRECT(MOUSECOORDS, NEWPARENT->position.x, NEWPARENT->position.y, NEWPARENT->position.x + NEWPARENT->size.x / 2.f, NEWPARENT->position.y + NEWPARENT->size.y))
@@ -319,7 +394,7 @@ void CHyprDwindleLayout::onWindowRemoved(CWindow* pWindow) {
     const auto PPARENT = PNODE->pParent;
 
     if (!PPARENT) {
-        m_lDwindleNodesData.remove(*PNODE);
+        freeNode(PNODE);
         return;
     }
 
@@ -365,11 +440,16 @@ void CHyprDwindleLayout::onWindowRemoved(CWindow* pWindow) {
     else 
         PSIBLING->recalcSizePosRecursive();
 
-    m_lDwindleNodesData.remove(*PPARENT);
-    m_lDwindleNodesData.remove(*PNODE);
+    freeNode(PPARENT);
+    freeNode(PNODE);
 }
 
 void CHyprDwindleLayout::recalculateMonitor(const int& monid) {
+    if (g_pCompositor->isBatching()) {
+        m_sBatchedMonitors.insert(monid);
+        return;
+    }
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(monid);
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(PMONITOR->activeWorkspace);
 
@@ -400,6 +480,8 @@ void CHyprDwindleLayout::recalculateMonitor(const int& monid) {
 }
 
 void CHyprDwindleLayout::changeWindowFloatingMode(CWindow* pWindow) {
+    // floating windows are drawn in their own pass
+    g_pHyprRenderer->invalidateRenderLists();
 
     if (pWindow->m_bIsFullscreen) {
         Debug::log(LOG, "Rejecting a change float order because window is fullscreen.");
@@ -415,6 +497,7 @@ void CHyprDwindleLayout::changeWindowFloatingMode(CWindow* pWindow) {
         const auto PNEWMON = g_pCompositor->getMonitorFromVector(pWindow->m_vRealPosition.vec() + pWindow->m_vRealSize.vec() / 2.f);
         pWindow->m_iMonitorID = PNEWMON->ID;
         pWindow->m_iWorkspaceID = PNEWMON->activeWorkspace;
+        g_pCompositor->invalidateWindowIndex();
 
         // save real pos cuz the func applies the default 5,5 mid
         const auto PSAVEDPOS = pWindow->m_vRealPosition.vec();
@@ -529,7 +612,11 @@ void CHyprDwindleLayout::onMouseMove(const Vector2D& mousePos) {
 
     if (PMONITOR) {
         DRAGGINGWINDOW->m_iMonitorID = PMONITOR->ID;
-        DRAGGINGWINDOW->m_iWorkspaceID = PMONITOR->activeWorkspace;
+
+        if (DRAGGINGWINDOW->m_iWorkspaceID != PMONITOR->activeWorkspace) {
+            DRAGGINGWINDOW->m_iWorkspaceID = PMONITOR->activeWorkspace;
+            g_pCompositor->invalidateWindowIndex();
+        }
     }
 
     g_pHyprRenderer->damageWindow(DRAGGINGWINDOW);
@@ -691,6 +778,7 @@ void CHyprDwindleLayout::fullscreenRequestForWindow(CWindow* pWindow, eFullscree
     // otherwise, accept it.
     pWindow->m_bIsFullscreen = !pWindow->m_bIsFullscreen;
     PWORKSPACE->m_bHasFullscreenWindow = !PWORKSPACE->m_bHasFullscreenWindow;
+    g_pHyprRenderer->invalidateRenderLists();
 
     if (!pWindow->m_bIsFullscreen) {
         // if it got its fullscreen disabled, set back its node if it had one
@@ -799,7 +887,7 @@ void CHyprDwindleLayout::toggleWindowGroup(CWindow* pWindow) {
 
         PPARENT->groupMembers = allChildren;
 
-        const auto GROUPINACTIVEBORDERCOL = CColor(g_pConfigManager->getInt("dwinle:col.group_border"));
+        const auto GROUPINACTIVEBORDERCOL = CColor(g_pConfigManager->getInt("dwindle:col.group_border"));
         for (auto& c : PPARENT->groupMembers) {
             c->pGroupParent = PPARENT;
             c->pWindow->m_cRealBorderColor = GROUPINACTIVEBORDERCOL;
@@ -886,12 +974,15 @@ SWindowRenderLayoutHints CHyprDwindleLayout::requestRenderHints(CWindow* pWindow
         return hints; // left for the future, maybe floating funkiness
 
     if (PNODE->pGroupParent) {
+        static auto *const PGROUPCOLACTIVE = &g_pConfigManager->getConfigValuePtr("dwindle:col.group_border_active")->intValue;
+        static auto *const PGROUPCOLINACTIVE = &g_pConfigManager->getConfigValuePtr("dwindle:col.group_border")->intValue;
+
         hints.isBorderColor = true;
 
         if (pWindow == g_pCompositor->m_pLastWindow)
-            hints.borderColor = CColor(g_pConfigManager->getInt("dwindle:col.group_border_active"));
+            hints.borderColor = CColor(*PGROUPCOLACTIVE);
         else
-            hints.borderColor = CColor(g_pConfigManager->getInt("dwindle:col.group_border"));
+            hints.borderColor = CColor(*PGROUPCOLINACTIVE);
     }
 
     return hints;
@@ -992,4 +1083,27 @@ void CHyprDwindleLayout::toggleSplit(CWindow* pWindow) {
 
 std::string CHyprDwindleLayout::getLayoutName() {
     return "dwindle";
-}
\ No newline at end of file
+}
+
+void CHyprDwindleLayout::onBatchEnd() {
+    const auto MONITORS = std::move(m_sBatchedMonitors);
+    m_sBatchedMonitors.clear();
+
+    // this applies everything on the visible workspaces, and takes those windows out of m_sBatchedWindows
+    for (auto& id : MONITORS) {
+        if (g_pCompositor->getMonitorFromID(id))
+            recalculateMonitor(id);
+    }
+
+    const auto WINDOWS = std::move(m_sBatchedWindows);
+    m_sBatchedWindows.clear();
+
+    for (auto& w : WINDOWS) {
+        // fullscreen windows got their box from fullscreenRequestForWindow
+        if (!g_pCompositor->windowValidMapped(w) || w->m_bIsFullscreen)
+            continue;
+
+        if (const auto PNODE = getNodeFromWindow(w); PNODE)
+            applyNodeDataToWindow(PNODE);
+    }
+}
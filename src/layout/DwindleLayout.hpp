@@ -3,6 +3,8 @@
 #include "IHyprLayout.hpp"
 #include <list>
 #include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include "../render/decorations/CHyprGroupBarDecoration.hpp"
 
 class CHyprDwindleLayout;
@@ -30,16 +32,20 @@ struct SDwindleNodeData {
 
     float           splitRatio = 1.f;
 
-    // For list lookup
-    bool operator==(const SDwindleNodeData& rhs) {
-        return pWindow == rhs.pWindow && workspaceID == rhs.workspaceID && position == rhs.position && size == rhs.size && pParent == rhs.pParent && children[0] == rhs.children[0] && children[1] == rhs.children[1];
-    }
+    // window nodes: position in SDwindleWorkspaceData::windowNodes
+    std::list<SDwindleNodeData*>::iterator workspaceIterator;
 
     void            recalcSizePosRecursive();
     void            getAllChildrenRecursive(std::deque<SDwindleNodeData*>*);
     CHyprDwindleLayout* layout = nullptr;
 };
 
+struct SDwindleWorkspaceData {
+    SDwindleNodeData*               root = nullptr; // cached, may be stale. See getMasterNodeOnWorkspace
+    std::list<SDwindleNodeData*>    windowNodes;    // in the order they were opened
+    int                             nodes = 0;      // incl. the split nodes
+};
+
 class CHyprDwindleLayout : public IHyprLayout {
 public:
     virtual void        onWindowCreated(CWindow*);
@@ -58,16 +64,28 @@ public:
     virtual void        switchWindows(CWindow*, CWindow*);
     virtual void        alterSplitRatioBy(CWindow*, float);
     virtual std::string getLayoutName();
+    virtual void        onBatchEnd();
 
    private:
 
-    std::list<SDwindleNodeData>     m_lDwindleNodesData;
+    // nodes never move in memory, freed ones get reused by allocateNode
+    std::deque<SDwindleNodeData>    m_dNodePool;
+    std::vector<SDwindleNodeData*>  m_vFreeNodes;
+
+    std::unordered_map<CWindow*, SDwindleNodeData*> m_mWindowNodes;
+    std::unordered_map<int, SDwindleWorkspaceData>  m_mWorkspaceData;
 
     Vector2D                        m_vBeginDragXY;
     Vector2D                        m_vLastDragXY;
     Vector2D                        m_vBeginDragPositionXY;
     Vector2D                        m_vBeginDragSizeXY;
 
+    // held back while batching, see onBatchEnd
+    std::unordered_set<int>         m_sBatchedMonitors;
+    std::unordered_set<CWindow*>    m_sBatchedWindows;
+
+    SDwindleNodeData*   allocateNode(const int& workspaceID, CWindow* pWindow);
+    void                freeNode(SDwindleNodeData*);
     int                 getNodesOnWorkspace(const int&);
     void                applyNodeDataToWindow(SDwindleNodeData*);
     SDwindleNodeData*   getNodeFromWindow(CWindow*);
@@ -110,4 +110,11 @@ public:
         Called when something wants the current layout's name
     */
     virtual std::string  getLayoutName() = 0;
+
+    /*
+        Called when a [[BATCH]] ends. While g_pCompositor->isBatching(),
+        the layout may keep its own state up to date but hold back
+        moving the actual windows, and has to apply it all here.
+    */
+    virtual void         onBatchEnd() = 0;
 };
\ No newline at end of file
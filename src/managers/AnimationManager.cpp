@@ -8,6 +8,7 @@ CAnimationManager::CAnimationManager() {
 
 void CAnimationManager::removeAllBeziers() {
     m_mBezierCurves.clear();
+    m_iBezierGeneration++;
 
     // add the default one
     std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
@@ -17,9 +18,47 @@ void CAnimationManager::removeAllBeziers() {
 void CAnimationManager::addBezierWithName(std::string name, const Vector2D& p1, const Vector2D& p2) {
     std::vector points = {p1, p2};
     m_mBezierCurves[name].setup(&points);
+    m_iBezierGeneration++;
 }
 
-void CAnimationManager::tick() {
+void CAnimationManager::scheduleAnimation(CAnimatedVariable* pVar) {
+    // the bezier is looked up once per animation, not once per frame
+    resolveBezier(pVar);
+
+    if (pVar->m_iActiveIndex != -1)
+        return;
+
+    pVar->m_iActiveIndex = m_vActiveAnimatedVariables.size();
+    m_vActiveAnimatedVariables.push_back(pVar);
+}
+
+void CAnimationManager::unscheduleAnimation(CAnimatedVariable* pVar) {
+    if (pVar->m_iActiveIndex == -1)
+        return;
+
+    // swap with the last one and pop
+    const auto LAST = m_vActiveAnimatedVariables.back();
+    m_vActiveAnimatedVariables[pVar->m_iActiveIndex] = LAST;
+    LAST->m_iActiveIndex = pVar->m_iActiveIndex;
+    m_vActiveAnimatedVariables.pop_back();
+
+    pVar->m_iActiveIndex = -1;
+}
+
+void CAnimationManager::resolveBezier(CAnimatedVariable* pVar) {
+    static auto *const  BEZIERSTR         = &g_pConfigManager->getConfigValuePtr("animations:curve")->strValue;
+
+    auto BEZIER = m_mBezierCurves.find(pVar->m_pBezier ? *pVar->m_pBezier : *BEZIERSTR);
+    if (BEZIER == m_mBezierCurves.end())
+        BEZIER = m_mBezierCurves.find(*BEZIERSTR);
+    if (BEZIER == m_mBezierCurves.end())
+        BEZIER = m_mBezierCurves.find("default");
+
+    pVar->m_pResolvedBezier = &BEZIER->second;
+    pVar->m_iBezierGeneration = m_iBezierGeneration;
+}
+
+void CAnimationManager::tick(SMonitor* pMonitor, const std::chrono::steady_clock::time_point& presentation) {
 
     bool animationsDisabled = false;
 
@@ -30,21 +69,44 @@ void CAnimationManager::tick() {
 
     static auto *const  PANIMSPEED        = &g_pConfigManager->getConfigValuePtr("animations:speed")->floatValue;
     static auto *const  PBORDERSIZE       = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
-    static auto *const  BEZIERSTR         = &g_pConfigManager->getConfigValuePtr("animations:curve")->strValue;
 
-    auto DEFAULTBEZIER = m_mBezierCurves.find(*BEZIERSTR);
-    if (DEFAULTBEZIER == m_mBezierCurves.end())
-        DEFAULTBEZIER = m_mBezierCurves.find("default");
+    // one timestamp for the whole tick, the one the frame will be shown at
+    const auto NOW = presentation;
 
-    for (auto& av : m_lAnimatedVariables) {
-        // get speed
-        const auto SPEED = *av->m_pSpeed == 0 ? *PANIMSPEED : *av->m_pSpeed;
+    // indexed, because finished vars get swapped out of the set as we go
+    for (size_t i = 0; i < m_vActiveAnimatedVariables.size();) {
+        const auto av = m_vActiveAnimatedVariables[i];
+
+        if (!av->isBeingAnimated()) {
+            // a workspace done sliding or fading out drops off its monitor's render list
+            if (av->m_pWorkspace)
+                g_pHyprRenderer->invalidateRenderLists();
+
+            unscheduleAnimation(av);
+            continue; // dont process
+        }
+
+        i++;
 
         // window stuff
         const auto PWINDOW = (CWindow*)av->m_pWindow;
         const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace;
         const auto PLAYER = (SLayerSurface*)av->m_pLayer;
 
+        // every monitor ticks its own vars, at its own pace. Vars without a (valid) monitor go with whichever ticks first.
+        const uint64_t OWNERMONITOR = PWINDOW ? PWINDOW->m_iMonitorID : PWORKSPACE ? PWORKSPACE->m_iMonitorID : PLAYER ? PLAYER->monitorID : -1;
+        if (OWNERMONITOR != pMonitor->ID && g_pCompositor->getMonitorFromID(OWNERMONITOR))
+            continue;
+
+        // the beziers got reloaded since this started
+        if (av->m_iBezierGeneration != m_iBezierGeneration)
+            resolveBezier(av);
+
+        const auto BEZIER = av->m_pResolvedBezier;
+
+        // get speed
+        const auto SPEED = *av->m_pSpeed == 0 ? *PANIMSPEED : *av->m_pSpeed;
+
         wlr_box WLRBOXPREV = {0,0,0,0};
         if (PWINDOW) {
             WLRBOXPREV = {(int)PWINDOW->m_vRealPosition.vec().x - (int)*PBORDERSIZE - 1, (int)PWINDOW->m_vRealPosition.vec().y - (int)*PBORDERSIZE - 1, (int)PWINDOW->m_vRealSize.vec().x + 2 * (int)*PBORDERSIZE + 2, (int)PWINDOW->m_vRealSize.vec().y + 2 * (int)*PBORDERSIZE + 2};
@@ -59,7 +121,7 @@ void CAnimationManager::tick() {
         // TODO: maybe do something cleaner
 
         // get the spent % (0 - 1)
-        const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - av->animationBegin).count();
+        const auto DURATIONPASSED = std::chrono::duration<float, std::milli>(NOW - av->animationBegin).count();
         const float SPENT = std::clamp((DURATIONPASSED / 100.f) / SPEED, 0.f, 1.f);
 
         switch (av->m_eVarType) {
@@ -73,12 +135,7 @@ void CAnimationManager::tick() {
                     }
 
                     const auto DELTA = av->m_fGoal - av->m_fBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_fValue = av->m_fBegun + BEZIER->second.getYForPoint(SPENT) * DELTA;
-                    else
-                        av->m_fValue = av->m_fBegun + DEFAULTBEZIER->second.getYForPoint(SPENT) * DELTA;
+                    av->m_fValue = av->m_fBegun + BEZIER->getYForPoint(SPENT) * DELTA;
 
                     if (SPENT >= 1.f) {
                         av->warp();
@@ -98,12 +155,7 @@ void CAnimationManager::tick() {
                     }
 
                     const auto DELTA = av->m_vGoal - av->m_vBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_vValue = av->m_vBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                    else
-                        av->m_vValue = av->m_vBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
+                    av->m_vValue = av->m_vBegun + DELTA * BEZIER->getYForPoint(SPENT);
 
                     if (SPENT >= 1.f) {
                         av->warp();
@@ -123,12 +175,7 @@ void CAnimationManager::tick() {
                     }
 
                     const auto DELTA = av->m_cGoal - av->m_cBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_cValue = av->m_cBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                    else
-                        av->m_cValue = av->m_cBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
+                    av->m_cValue = av->m_cBegun + DELTA * BEZIER->getYForPoint(SPENT);
 
                     if (SPENT >= 1.f) {
                         av->warp();
@@ -292,7 +339,9 @@ void CAnimationManager::animationSlide(CWindow* pWindow, std::string force, bool
 }
 
 void CAnimationManager::onWindowPostCreateClose(CWindow* pWindow, bool close) {
-    auto ANIMSTYLE = g_pConfigManager->getString("animations:windows_style");
+    static auto *const PANIMSTYLE = &g_pConfigManager->getConfigValuePtr("animations:windows_style")->strValue;
+
+    auto ANIMSTYLE = *PANIMSTYLE;
     transform(ANIMSTYLE.begin(), ANIMSTYLE.end(), ANIMSTYLE.begin(), ::tolower);
 
     // if the window is not being animated, that means the layout set a fixed size for it, don't animate.
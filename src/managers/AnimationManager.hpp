@@ -2,9 +2,11 @@
 
 #include "../defines.hpp"
 #include <list>
+#include <vector>
 #include <unordered_map>
 #include "../helpers/AnimatedVariable.hpp"
 #include "../helpers/BezierCurve.hpp"
+#include "../helpers/Monitor.hpp"
 #include "../Window.hpp"
 
 class CAnimationManager {
@@ -12,13 +14,16 @@ public:
 
     CAnimationManager();
 
-    void            tick();
+    // advances the animations shown on pMonitor to the time its next frame will be presented
+    void            tick(SMonitor* pMonitor, const std::chrono::steady_clock::time_point& presentation);
     void            addBezierWithName(std::string, const Vector2D&, const Vector2D&);
     void            removeAllBeziers();
 
     void            onWindowPostCreateClose(CWindow*, bool close = false);
 
-    std::list<CAnimatedVariable*> m_lAnimatedVariables;
+    // adds / removes a var from the set that gets ticked
+    void            scheduleAnimation(CAnimatedVariable*);
+    void            unscheduleAnimation(CAnimatedVariable*);
 
 private:
     bool            deltaSmallToFlip(const Vector2D& a, const Vector2D& b);
@@ -28,7 +33,13 @@ private:
     bool            deltazero(const CColor& a, const CColor& b);
     bool            deltazero(const float& a, const float& b);
 
+    void            resolveBezier(CAnimatedVariable*);
+
     std::unordered_map<std::string, CBezierCurve> m_mBezierCurves;
+    size_t          m_iBezierGeneration = 1; // bumped whenever m_mBezierCurves changes
+
+    // only the vars that are in flight, the tick doesn't look at anything else
+    std::vector<CAnimatedVariable*> m_vActiveAnimatedVariables;
 
     // Anim stuff
     void            animationPopin(CWindow*, bool close = false);
@@ -4,9 +4,11 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -14,13 +16,57 @@
 #include <unistd.h>
 
 #include <string>
+#include <unordered_set>
+
+// how much a client can lag behind before we start dropping its events
+constexpr size_t SOCKET2_MAX_PENDING_BYTES = 1024 * 1024;
+// how many events can pile up before the socket thread picks them up
+constexpr size_t SOCKET2_MAX_QUEUED_EVENTS = 4096;
 
 CEventManager::CEventManager() {
+    m_iEventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_iEventFD < 0)
+        Debug::log(ERR, "Couldn't create the socket 2 eventfd. IPC events will not work.");
+}
+
+bool CEventManager::flushClient(SSocket2Client& client) {
+    while (!client.pending.empty()) {
+        const auto WRITTEN = send(client.fd, client.pending.data(), client.pending.length(), MSG_NOSIGNAL);
+
+        if (WRITTEN < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return true; // will continue once it's writable
+
+            return false;
+        }
+
+        client.pending.erase(0, WRITTEN);
+    }
+
+    if (client.dropping) {
+        Debug::log(LOG, "Socket 2 client at FD %d caught up, no longer dropping events", client.fd);
+        client.dropping = false;
+    }
+
+    return true;
+}
+
+void CEventManager::queueForClient(SSocket2Client& client, const std::string& eventString) {
+    if (client.pending.length() + eventString.length() > SOCKET2_MAX_PENDING_BYTES) {
+        if (!client.dropping)
+            Debug::log(WARN, "Socket 2 client at FD %d is not reading its events, dropping them", client.fd);
+
+        client.dropping = true;
+        return;
+    }
+
+    client.pending += eventString;
 }
 
 void CEventManager::startThread() {
     std::thread([&]() {
-        const auto SOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
+        const auto SOCKET = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
 
         if (SOCKET < 0) {
             Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (1) IPC will not work.");
@@ -47,57 +93,100 @@ void CEventManager::startThread() {
         int flags = fcntl(SOCKET, F_GETFL, 0);
         fcntl(SOCKET, F_SETFL, flags | O_NONBLOCK);
 
+        std::vector<pollfd> pollFDs;
+        std::deque<SHyprIPCEvent> events;
+
         while (1) {
+            // sleep until there's a new client, an event, or a client is readable / writable
+            pollFDs.clear();
+            pollFDs.push_back({SOCKET, POLLIN, 0});
+            pollFDs.push_back({m_iEventFD, POLLIN, 0});
+            for (auto& c : m_vClients)
+                pollFDs.push_back({c.fd, (short)(POLLIN | (c.pending.empty() ? 0 : POLLOUT)), 0});
+
+            if (poll(pollFDs.data(), pollFDs.size(), -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                Debug::log(ERR, "Socket 2 poll failed with errno %d, IPC events will stop.", errno);
+                break;
+            }
 
-            const auto ACCEPTEDCONNECTION = accept(SOCKET, (sockaddr*)&clientAddress, &clientSize);
+            // existing clients first, the indices match m_vClients until we accept anything
+            for (size_t i = 2; i < pollFDs.size(); ++i) {
+                auto& client = m_vClients[i - 2];
+                const auto REVENTS = pollFDs[i].revents;
+
+                if (REVENTS & (POLLERR | POLLNVAL)) {
+                    client.dead = true;
+                    continue;
+                }
 
-            if (ACCEPTEDCONNECTION > 0) {
-                // new connection!
-                m_dAcceptedSocketFDs.push_back(ACCEPTEDCONNECTION);
+                if (REVENTS & (POLLIN | POLLHUP)) {
+                    // we don't expect anything from them, 0 means they're gone
+                    const auto SIZEREAD = recv(client.fd, &readBuf, 1024, 0);
 
-                int flagsNew = fcntl(ACCEPTEDCONNECTION, F_GETFL, 0);
-                fcntl(ACCEPTEDCONNECTION, F_SETFL, flagsNew | O_NONBLOCK);
+                    if (SIZEREAD == 0 || (SIZEREAD < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        client.dead = true;
+                        continue;
+                    }
+                }
 
-                Debug::log(LOG, "Socket 2 accepted a new client at FD %d", ACCEPTEDCONNECTION);
+                if (REVENTS & POLLOUT && !flushClient(client))
+                    client.dead = true;
             }
 
-            // pong if all FDs valid
-            for (auto it = m_dAcceptedSocketFDs.begin(); it != m_dAcceptedSocketFDs.end();) {
-                auto sizeRead = recv(*it, &readBuf, 1024, 0);
+            if (pollFDs[0].revents & POLLIN) {
+                while (1) {
+                    const auto ACCEPTEDCONNECTION = accept4(SOCKET, (sockaddr*)&clientAddress, &clientSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
 
-                if (sizeRead != 0) {
-                    it++;
-                    continue;
-                }
+                    if (ACCEPTEDCONNECTION < 0)
+                        break;
 
-                // invalid!
-                Debug::log(LOG, "Removed invalid socket (2) FD: %d", *it);
-                it = m_dAcceptedSocketFDs.erase(it);
+                    // new connection!
+                    m_vClients.push_back({ACCEPTEDCONNECTION});
+
+                    Debug::log(LOG, "Socket 2 accepted a new client at FD %d", ACCEPTEDCONNECTION);
+                }
             }
 
-            // valid FDs, check the queue
-            // don't do anything if main thread is writing to the eventqueue
-            eventQueueMutex.lock();
+            if (pollFDs[1].revents & POLLIN) {
+                uint64_t wakeups = 0;
+                read(m_iEventFD, &wakeups, sizeof(wakeups));
 
-            if (m_dQueuedEvents.empty()){ // if queue empty, sleep and ignore
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                // take the whole queue at once, don't hold the main thread up while writing
+                eventQueueMutex.lock();
+                events.swap(m_dQueuedEvents);
                 eventQueueMutex.unlock();
-                continue;
-            }
 
-            // write all queued events
-            for (auto& ev : m_dQueuedEvents) {
-                std::string eventString = ev.event + ">>" + ev.data + "\n";
-                for (auto& fd : m_dAcceptedSocketFDs) {
-                    write(fd, eventString.c_str(), eventString.length());
+                for (auto& ev : events) {
+                    const std::string EVENTSTRING = ev.event + ">>" + ev.data + "\n";
+
+                    for (auto& c : m_vClients) {
+                        if (!c.dead)
+                            queueForClient(c, EVENTSTRING);
+                    }
                 }
-            }
 
-            m_dQueuedEvents.clear();
+                events.clear();
 
-            eventQueueMutex.unlock();
+                for (auto& c : m_vClients) {
+                    if (!c.dead && !flushClient(c))
+                        c.dead = true;
+                }
+            }
+
+            // cleanup
+            for (auto it = m_vClients.begin(); it != m_vClients.end();) {
+                if (!it->dead) {
+                    it++;
+                    continue;
+                }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                Debug::log(LOG, "Removed invalid socket (2) FD: %d", it->fd);
+                close(it->fd);
+                it = m_vClients.erase(it);
+            }
         }
 
         close(SOCKET);
@@ -105,9 +194,59 @@ void CEventManager::startThread() {
 }
 
 void CEventManager::postEvent(const SHyprIPCEvent event) {
-    std::thread([&](const SHyprIPCEvent ev) {
-        eventQueueMutex.lock();
-        m_dQueuedEvents.push_back(ev);
-        eventQueueMutex.unlock();
-    }, event).detach();
-}
\ No newline at end of file
+    if (m_iEventFD < 0)
+        return;
+
+    if (g_pCompositor->isBatching()) {
+        m_dBatchedEvents.push_back(event);
+        return;
+    }
+
+    eventQueueMutex.lock();
+
+    if (m_dQueuedEvents.size() >= SOCKET2_MAX_QUEUED_EVENTS)
+        m_dQueuedEvents.pop_front();
+
+    m_dQueuedEvents.push_back(event);
+
+    eventQueueMutex.unlock();
+
+    // wake up the socket thread
+    const uint64_t ONE = 1;
+    write(m_iEventFD, &ONE, sizeof(ONE));
+}
+
+void CEventManager::flushBatchedEvents() {
+    if (m_dBatchedEvents.empty())
+        return;
+
+    // these describe the current state, so listeners only care about the last one
+    const auto ISSTATEEVENT = [](const std::string& event) { return event == "activewindow" || event == "workspace" || event == "activemon"; };
+
+    std::unordered_set<std::string> seenStateEvents;
+    std::deque<SHyprIPCEvent> coalesced;
+
+    for (auto it = m_dBatchedEvents.rbegin(); it != m_dBatchedEvents.rend(); ++it) {
+        if (ISSTATEEVENT(it->event) && !seenStateEvents.insert(it->event).second)
+            continue;
+
+        coalesced.push_front(*it);
+    }
+
+    m_dBatchedEvents.clear();
+
+    eventQueueMutex.lock();
+
+    for (auto& e : coalesced) {
+        if (m_dQueuedEvents.size() >= SOCKET2_MAX_QUEUED_EVENTS)
+            m_dQueuedEvents.pop_front();
+
+        m_dQueuedEvents.push_back(e);
+    }
+
+    eventQueueMutex.unlock();
+
+    // one wakeup for the whole batch
+    const uint64_t ONE = 1;
+    write(m_iEventFD, &ONE, sizeof(ONE));
+}
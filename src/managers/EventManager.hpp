@@ -2,6 +2,7 @@
 #include <deque>
 #include <fstream>
 #include <mutex>
+#include <vector>
 
 #include "../defines.hpp"
 #include "../helpers/MiscFunctions.hpp"
@@ -11,20 +12,39 @@ struct SHyprIPCEvent {
     std::string data;
 };
 
+// a socket2 listener, with whatever we couldn't write to it yet
+struct SSocket2Client {
+    int         fd = -1;
+    std::string pending = "";
+    bool        dropping = false; // too slow, events are being dropped
+    bool        dead = false;
+};
+
 class CEventManager {
 public:
     CEventManager();
 
     void postEvent(const SHyprIPCEvent event);
+    void flushBatchedEvents();
 
     void startThread();
 
 private:
 
+    bool flushClient(SSocket2Client&);
+    void queueForClient(SSocket2Client&, const std::string&);
+
     std::mutex eventQueueMutex;
     std::deque<SHyprIPCEvent> m_dQueuedEvents;
 
-    std::deque<int> m_dAcceptedSocketFDs;
+    // held back while g_pCompositor->isBatching(), main thread only
+    std::deque<SHyprIPCEvent> m_dBatchedEvents;
+
+    // wakes up the socket thread when events get posted
+    int m_iEventFD = -1;
+
+    // only touched by the socket thread
+    std::vector<SSocket2Client> m_vClients;
 };
 
-inline std::unique_ptr<CEventManager> g_pEventManager;
\ No newline at end of file
+inline std::unique_ptr<CEventManager> g_pEventManager;
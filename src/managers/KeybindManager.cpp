@@ -32,16 +32,56 @@ CKeybindManager::CKeybindManager() {
     m_mDispatchers["focuswindowbyclass"]        = focusWindowByClass;
 }
 
+static uint64_t keybindHash(uint32_t modmask, xkb_keysym_t keysym) {
+    return ((uint64_t)modmask << 32) | keysym;
+}
+
 void CKeybindManager::addKeybind(SKeybind kb) {
+    // resolve everything once here, a key press only does a hash lookup
+    kb.keysym = xkb_keysym_from_name(kb.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+    kb.keysymUpper = xkb_keysym_to_upper(kb.keysym);
+    // small TODO: fix 0-9 keys and other modified ones with shift
+
+    if (kb.keysym == XKB_KEY_NoSymbol)
+        Debug::log(ERR, "Keybind key %s is not a valid keysym, it will never trigger", kb.key.c_str());
+
+    kb.command = compileDispatch(kb.handler, kb.arg);
+
     m_lKeybinds.push_back(kb);
+
+    indexKeybind(&m_lKeybinds.back());
+}
+
+const std::vector<SKeybind*>* CKeybindManager::getKeybindsFor(uint32_t modmask, xkb_keysym_t keysym) {
+    const auto BINDS = m_mKeybindTable.find(keybindHash(modmask, keysym));
+
+    return BINDS == m_mKeybindTable.end() ? nullptr : &BINDS->second;
+}
+
+void CKeybindManager::indexKeybind(SKeybind* pKeybind) {
+    if (pKeybind->keysym == XKB_KEY_NoSymbol)
+        return;
+
+    m_mKeybindTable[keybindHash(pKeybind->modmask, pKeybind->keysym)].push_back(pKeybind);
+
+    if (pKeybind->keysymUpper != pKeybind->keysym)
+        m_mKeybindTable[keybindHash(pKeybind->modmask, pKeybind->keysymUpper)].push_back(pKeybind);
+}
+
+void CKeybindManager::rebuildKeybindTable() {
+    m_mKeybindTable.clear();
+
+    for (auto& k : m_lKeybinds)
+        indexKeybind(&k);
 }
 
 void CKeybindManager::removeKeybind(uint32_t mod, const std::string& key) {
-    for (auto it = m_lKeybinds.begin(); it != m_lKeybinds.end(); ++it) {
-        if (it->modmask == mod && it->key == key) {
-            it = m_lKeybinds.erase(it);
-        }
-    }
+    const auto SIZEBEFORE = m_lKeybinds.size();
+
+    m_lKeybinds.remove_if([&](const SKeybind& other) { return other.modmask == mod && other.key == key; });
+
+    if (m_lKeybinds.size() != SIZEBEFORE)
+        rebuildKeybindTable();
 }
 
 uint32_t CKeybindManager::stringToModMask(std::string mods) {
@@ -77,29 +117,19 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const xkb_keysym_t
         return false;
     }
 
-    for (auto& k : m_lKeybinds) {
-        if (modmask != k.modmask) 
-            continue;
-
-        // oMg such performance hit!!11!
-        // this little maneouver is gonna cost us 4µs
-        const auto KBKEY = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
-        const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
-        // small TODO: fix 0-9 keys and other modified ones with shift
-        
-        if (key != KBKEY && key != KBKEYUPPER)
-            continue;
-
+    const auto BINDS = getKeybindsFor(modmask, key);
 
-        const auto DISPATCHER = m_mDispatchers.find(k.handler);
+    if (!BINDS)
+        return false;
 
+    for (auto& k : *BINDS) {
         // Should never happen, as we check in the ConfigManager, but oh well
-        if (DISPATCHER == m_mDispatchers.end()) {
-            Debug::log(ERR, "Inavlid handler in a keybind! (handler %s does not exist)", k.handler.c_str());
+        if (!k->command.dispatcher) {
+            Debug::log(ERR, "Inavlid handler in a keybind! (handler %s does not exist)", k->handler.c_str());
         } else {
             // call the dispatcher
-            Debug::log(LOG, "Keybind triggered, calling dispatcher (%d, %d)", modmask, KBKEYUPPER);
-            DISPATCHER->second(k.arg);
+            Debug::log(LOG, "Keybind triggered, calling dispatcher (%d, %d)", modmask, k->keysymUpper);
+            executeDispatch(k->command);
         }
 
         found = true;
@@ -108,6 +138,93 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const xkb_keysym_t
     return found;
 }
 
+SDispatchCommand CKeybindManager::compileDispatch(const std::string& handler, const std::string& arg) {
+    SDispatchCommand command;
+
+    const auto DISPATCHER = m_mDispatchers.find(handler);
+
+    command.dispatcher = DISPATCHER == m_mDispatchers.end() ? nullptr : &DISPATCHER->second;
+    command.arg = arg;
+
+    if (!command.dispatcher)
+        return command;
+
+    // args that don't parse stay DISPATCH_CALL, so the dispatcher reports the error like it always did
+    if (handler == "workspace" || handler == "movetoworkspace" || handler == "movetoworkspacesilent") {
+        command.workspace = parseWorkspaceTarget(arg);
+
+        if (command.workspace.type == SWorkspaceTarget::INVALID)
+            return command;
+
+        command.op = handler == "workspace" ? DISPATCH_WORKSPACE : handler == "movetoworkspace" ? DISPATCH_MOVETOWORKSPACE : DISPATCH_MOVETOWORKSPACESILENT;
+    } else if ((handler == "movefocus" || handler == "movewindow") && isDirection(arg)) {
+        command.op = handler == "movefocus" ? DISPATCH_MOVEFOCUS : DISPATCH_MOVEWINDOW;
+        command.direction = arg[0];
+    } else if (handler == "splitratio") {
+        if (arg == "+" || arg == "-")
+            return command; // legacy syntax, let it warn
+
+        command.delta = getPlusMinusKeywordResult(arg, 0);
+
+        if (command.delta != INT_MAX && command.delta != 0)
+            command.op = DISPATCH_SPLITRATIO;
+    } else if (handler == "resizeactive") {
+        if (arg.find_first_of(' ') == std::string::npos)
+            return command;
+
+        const auto X = arg.substr(0, arg.find_first_of(' '));
+        const auto Y = arg.substr(arg.find_first_of(' ') + 1);
+
+        if (!isNumber(X) || !isNumber(Y))
+            return command;
+
+        try {
+            command.pixelDelta = Vector2D(std::stoi(X), std::stoi(Y));
+            command.op = DISPATCH_RESIZEACTIVE;
+        } catch (...) {
+            // "-" and friends pass isNumber
+        }
+    } else if (handler == "workspaceopt" && (arg == "allfloat" || arg == "allpseudo")) {
+        command.op = DISPATCH_WORKSPACEOPT;
+        command.floating = arg == "allfloat";
+    }
+
+    return command;
+}
+
+void CKeybindManager::executeDispatch(const SDispatchCommand& command) {
+    switch (command.op) {
+        case DISPATCH_WORKSPACE:
+            changeWorkspaceTo(command.workspace);
+            break;
+        case DISPATCH_MOVETOWORKSPACE:
+            moveActiveToWorkspaceTarget(command.workspace);
+            break;
+        case DISPATCH_MOVETOWORKSPACESILENT:
+            moveActiveToWorkspaceSilentTarget(command.workspace);
+            break;
+        case DISPATCH_MOVEFOCUS:
+            moveFocusInDirection(command.direction);
+            break;
+        case DISPATCH_MOVEWINDOW:
+            moveActiveInDirection(command.direction);
+            break;
+        case DISPATCH_SPLITRATIO:
+            alterSplitRatioBy(command.delta);
+            break;
+        case DISPATCH_RESIZEACTIVE:
+            resizeActiveBy(command.pixelDelta);
+            break;
+        case DISPATCH_WORKSPACEOPT:
+            toggleWorkspaceOpt(command.floating);
+            break;
+        case DISPATCH_CALL:
+            if (command.dispatcher)
+                (*command.dispatcher)(command.arg);
+            break;
+    }
+}
+
 bool CKeybindManager::handleInternalKeybinds(xkb_keysym_t keysym) {
     // Handles the CTRL+ALT+FX TTY keybinds
     if (!(keysym >= XKB_KEY_XF86Switch_VT_1 && keysym <= XKB_KEY_XF86Switch_VT_12))
@@ -198,6 +315,7 @@ void CKeybindManager::killActive(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_lKeybinds.clear();
+    m_mKeybindTable.clear();
 }
 
 void CKeybindManager::toggleActiveFloating(std::string args) {
@@ -229,10 +347,14 @@ void CKeybindManager::toggleActivePseudo(std::string args) {
 }
 
 void CKeybindManager::changeworkspace(std::string args) {
+    changeWorkspaceTo(parseWorkspaceTarget(args));
+}
+
+void CKeybindManager::changeWorkspaceTo(const SWorkspaceTarget& target) {
     int workspaceToChangeTo = 0;
     std::string workspaceName = "";
 
-    workspaceToChangeTo = getWorkspaceIDFromString(args, workspaceName);
+    workspaceToChangeTo = getWorkspaceIDFromTarget(target, workspaceName);
 
     if (workspaceToChangeTo == INT_MAX) {
         Debug::log(ERR, "Error in changeworkspace, invalid value");
@@ -263,6 +385,8 @@ void CKeybindManager::changeworkspace(std::string args) {
             else
                 PMONITOR->specialWorkspaceOpen = true;
 
+            g_pHyprRenderer->invalidateRenderLists();
+
             // we need to move XWayland windows to narnia or otherwise they will still process our cursor and shit
             // and that'd be annoying as hell
             g_pCompositor->fixXWaylandWindowsOnWorkspace(OLDWORKSPACEID);
@@ -335,6 +459,7 @@ void CKeybindManager::changeworkspace(std::string args) {
         wlr_ext_workspace_handle_v1_set_name(PWORKSPACE->m_pWlrHandle, workspaceName.c_str());
 
     PWORKSPACE->m_iID = workspaceToChangeTo;
+    g_pCompositor->invalidateWorkspaceIndex();
     PWORKSPACE->m_iMonitorID = PMONITOR->ID;
     PWORKSPACE->m_szName = workspaceName;
 
@@ -383,6 +508,10 @@ void CKeybindManager::fullscreenActive(std::string args) {
 }
 
 void CKeybindManager::moveActiveToWorkspace(std::string args) {
+    moveActiveToWorkspaceTarget(parseWorkspaceTarget(args));
+}
+
+void CKeybindManager::moveActiveToWorkspaceTarget(const SWorkspaceTarget& target) {
     const auto PWINDOW = g_pCompositor->m_pLastWindow;
 
     if (!g_pCompositor->windowValidMapped(PWINDOW))
@@ -392,7 +521,7 @@ void CKeybindManager::moveActiveToWorkspace(std::string args) {
 
     // hack
     std::string unusedName;
-    const auto WORKSPACEID = getWorkspaceIDFromString(args, unusedName);
+    const auto WORKSPACEID = getWorkspaceIDFromTarget(target, unusedName);
 
     if (WORKSPACEID == PWINDOW->m_iWorkspaceID) {
         Debug::log(LOG, "Not moving to workspace because it didn't change.");
@@ -401,7 +530,7 @@ void CKeybindManager::moveActiveToWorkspace(std::string args) {
 
     g_pLayoutManager->getCurrentLayout()->onWindowRemoved(PWINDOW);
 
-    g_pKeybindManager->changeworkspace(args);
+    changeWorkspaceTo(target);
 
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(WORKSPACEID);
 
@@ -418,6 +547,7 @@ void CKeybindManager::moveActiveToWorkspace(std::string args) {
     OLDWORKSPACE->m_bHasFullscreenWindow = false;
 
     PWINDOW->m_iWorkspaceID = PWORKSPACE->m_iID;
+    g_pCompositor->invalidateWindowIndex();
     PWINDOW->m_iMonitorID = PWORKSPACE->m_iMonitorID;
     PWINDOW->m_bIsFullscreen = false;
 
@@ -458,12 +588,16 @@ void CKeybindManager::moveActiveToWorkspace(std::string args) {
 }
 
 void CKeybindManager::moveActiveToWorkspaceSilent(std::string args) {
+    moveActiveToWorkspaceSilentTarget(parseWorkspaceTarget(args));
+}
+
+void CKeybindManager::moveActiveToWorkspaceSilentTarget(const SWorkspaceTarget& target) {
     // hacky, but works lol
 
     int workspaceToMoveTo = 0;
     std::string workspaceName = "";
 
-    workspaceToMoveTo = getWorkspaceIDFromString(args, workspaceName);
+    workspaceToMoveTo = getWorkspaceIDFromTarget(target, workspaceName);
 
     if (workspaceToMoveTo == INT_MAX) {
         Debug::log(ERR, "Error in moveActiveToWorkspaceSilent, invalid value");
@@ -493,7 +627,7 @@ void CKeybindManager::moveActiveToWorkspaceSilent(std::string args) {
 
     m_bSuppressWorkspaceChangeEvents = true;
 
-    moveActiveToWorkspace(args);
+    moveActiveToWorkspaceTarget(target);
 
     PWORKSPACE = g_pCompositor->getWorkspaceByID(workspaceToMoveTo);
 
@@ -523,6 +657,10 @@ void CKeybindManager::moveFocusTo(std::string args) {
         return;
     }
 
+    moveFocusInDirection(arg);
+}
+
+void CKeybindManager::moveFocusInDirection(char arg) {
     const auto PLASTWINDOW = g_pCompositor->m_pLastWindow;
 
     // remove constraints
@@ -586,6 +724,10 @@ void CKeybindManager::moveActiveTo(std::string args) {
         return;
     }
 
+    moveActiveInDirection(arg);
+}
+
+void CKeybindManager::moveActiveInDirection(char arg) {
     const auto PLASTWINDOW = g_pCompositor->m_pLastWindow;
 
     if (!g_pCompositor->windowValidMapped(PLASTWINDOW))
@@ -637,6 +779,10 @@ void CKeybindManager::alterSplitRatio(std::string args) {
         return;
     }
 
+    alterSplitRatioBy(splitratio);
+}
+
+void CKeybindManager::alterSplitRatioBy(float splitratio) {
     const auto PLASTWINDOW = g_pCompositor->m_pLastWindow;
 
     if (!g_pCompositor->windowValidMapped(PLASTWINDOW))
@@ -726,14 +872,22 @@ void CKeybindManager::moveCursorToCorner(std::string arg) {
 }
 
 void CKeybindManager::workspaceOpt(std::string args) {
-    
+    if (args != "allpseudo" && args != "allfloat") {
+        Debug::log(ERR, "Invalid arg in workspaceOpt, opt \"%s\" doesn't exist.", args.c_str());
+        return;
+    }
+
+    toggleWorkspaceOpt(args == "allfloat");
+}
+
+void CKeybindManager::toggleWorkspaceOpt(bool floating) {
     // current workspace
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(g_pCompositor->m_pLastMonitor->activeWorkspace);
 
     if (!PWORKSPACE)
         return; // ????
 
-    if (args == "allpseudo") {
+    if (!floating) {
         PWORKSPACE->m_bDefaultPseudo = !PWORKSPACE->m_bDefaultPseudo;
 
         // apply
@@ -743,7 +897,7 @@ void CKeybindManager::workspaceOpt(std::string args) {
 
             w.m_bIsPseudotiled = PWORKSPACE->m_bDefaultPseudo;
         }
-    } else if (args == "allfloat") {
+    } else {
         PWORKSPACE->m_bDefaultFloating = !PWORKSPACE->m_bDefaultFloating;
         // apply
 
@@ -772,9 +926,6 @@ void CKeybindManager::workspaceOpt(std::string args) {
                 }
             }
         }
-    } else {
-        Debug::log(ERR, "Invalid arg in workspaceOpt, opt \"%s\" doesn't exist.", args.c_str());
-        return;
     }
 
     // recalc mon
@@ -866,6 +1017,8 @@ void CKeybindManager::toggleSpecialWorkspace(std::string args) {
     else
         Debug::log(LOG, "Toggling special workspace to open");
 
+    g_pHyprRenderer->invalidateRenderLists();
+
     if (open) {
         for (auto& m : g_pCompositor->m_lMonitors) {
             if (m.specialWorkspaceOpen != !open) {
@@ -907,7 +1060,11 @@ void CKeybindManager::resizeActive(std::string args) {
     const int X = std::stoi(x);
     const int Y = std::stoi(y);
 
-    g_pLayoutManager->getCurrentLayout()->resizeActiveWindow(Vector2D(X, Y));
+    resizeActiveBy(Vector2D(X, Y));
+}
+
+void CKeybindManager::resizeActiveBy(const Vector2D& delta) {
+    g_pLayoutManager->getCurrentLayout()->resizeActiveWindow(delta);
 }
 
 void CKeybindManager::circleNext(std::string) {
@@ -6,11 +6,42 @@
 #include <unordered_map>
 #include <functional>
 
+enum eDispatchOp {
+    DISPATCH_CALL = 0, // anything without a typed path, calls the dispatcher with the raw arg
+    DISPATCH_WORKSPACE,
+    DISPATCH_MOVETOWORKSPACE,
+    DISPATCH_MOVETOWORKSPACESILENT,
+    DISPATCH_MOVEFOCUS,
+    DISPATCH_MOVEWINDOW,
+    DISPATCH_SPLITRATIO,
+    DISPATCH_RESIZEACTIVE,
+    DISPATCH_WORKSPACEOPT
+};
+
+// a dispatcher + arg, parsed once by compileDispatch
+struct SDispatchCommand {
+    eDispatchOp       op = DISPATCH_CALL;
+    std::function<void(std::string)>* dispatcher = nullptr; // nullptr if the dispatcher doesn't exist
+    std::string       arg = "";
+
+    // operands, depending on op
+    SWorkspaceTarget  workspace;
+    char              direction = 0;
+    float             delta = 0;
+    Vector2D          pixelDelta;
+    bool              floating = false; // workspaceopt: allfloat / allpseudo
+};
+
 struct SKeybind {
     std::string       key = 0;
     uint32_t          modmask = 0;
     std::string       handler = "";
     std::string       arg = "";
+
+    // resolved in addKeybind
+    xkb_keysym_t      keysym = XKB_KEY_NoSymbol;
+    xkb_keysym_t      keysymUpper = XKB_KEY_NoSymbol;
+    SDispatchCommand  command;
 };
 
 class CKeybindManager {
@@ -23,11 +54,23 @@ public:
     uint32_t            stringToModMask(std::string);
     void                clearKeybinds();
 
+    // the binds a key press would trigger, in config order. nullptr if none.
+    const std::vector<SKeybind*>* getKeybindsFor(uint32_t modmask, xkb_keysym_t keysym);
+
+    SDispatchCommand    compileDispatch(const std::string& handler, const std::string& arg);
+    void                executeDispatch(const SDispatchCommand&);
+
     std::unordered_map<std::string, std::function<void(std::string)>> m_mDispatchers;
 
 private:
     std::list<SKeybind> m_lKeybinds;
 
+    // (modmask << 32 | keysym) -> binds in config order. Points into m_lKeybinds.
+    std::unordered_map<uint64_t, std::vector<SKeybind*>> m_mKeybindTable;
+
+    void                indexKeybind(SKeybind*);
+    void                rebuildKeybindTable();
+
     bool                handleInternalKeybinds(xkb_keysym_t);
 
     inline static bool  m_bSuppressWorkspaceChangeEvents = false;
@@ -59,6 +102,16 @@ private:
     static void         circleNext(std::string);
     static void         focusWindowByClass(std::string);
 
+    // typed versions, the string ones above parse and forward here
+    static void         changeWorkspaceTo(const SWorkspaceTarget&);
+    static void         moveActiveToWorkspaceTarget(const SWorkspaceTarget&);
+    static void         moveActiveToWorkspaceSilentTarget(const SWorkspaceTarget&);
+    static void         moveFocusInDirection(char);
+    static void         moveActiveInDirection(char);
+    static void         alterSplitRatioBy(float);
+    static void         resizeActiveBy(const Vector2D&);
+    static void         toggleWorkspaceOpt(bool floating);
+
     friend class CCompositor;
 };
 
@@ -3,7 +3,8 @@
 #include "../events/Events.hpp"
 
 CHyprXWaylandManager::CHyprXWaylandManager() {
-    if (XWAYLAND) {
+    // a headless compositor has no display to put XWayland on
+    if (XWAYLAND && g_pCompositor->m_sWLDisplay) {
         m_sWLRXWayland = wlr_xwayland_create(g_pCompositor->m_sWLDisplay, g_pCompositor->m_sWLRCompositor, 1);
 
         if (!m_sWLRXWayland) {
@@ -91,26 +92,25 @@ std::string CHyprXWaylandManager::getTitle(CWindow* pWindow) {
 }
 
 std::string CHyprXWaylandManager::getAppIDClass(CWindow* pWindow) {
-    try {
-        if (pWindow->m_bIsX11) {
-            if (pWindow->m_uSurface.xwayland) {
-                if (!pWindow->m_bMappedX11 || !pWindow->m_bIsMapped)
-                    return "unmanaged X11";
+    return std::string(getAppIDClassView(pWindow));
+}
 
-                return std::string(pWindow->m_uSurface.xwayland->_class);
-            }
-        } else if (pWindow->m_uSurface.xdg) {
-            if (pWindow->m_uSurface.xdg->toplevel) {
-                return std::string(pWindow->m_uSurface.xdg->toplevel->app_id);
-            }
-        } else {
-            return "";
+std::string_view CHyprXWaylandManager::getAppIDClassView(CWindow* pWindow) {
+    const char* appIDClass = nullptr;
+
+    if (pWindow->m_bIsX11) {
+        if (pWindow->m_uSurface.xwayland) {
+            if (!pWindow->m_bMappedX11 || !pWindow->m_bIsMapped)
+                return "unmanaged X11";
+
+            appIDClass = pWindow->m_uSurface.xwayland->_class;
         }
-    } catch (std::logic_error& e) {
-        Debug::log(ERR, "Error in getAppIDClass: %s", e.what());
+    } else if (pWindow->m_uSurface.xdg && pWindow->m_uSurface.xdg->toplevel) {
+        appIDClass = pWindow->m_uSurface.xdg->toplevel->app_id;
     }
 
-    return "";
+    // clients don't have to set one
+    return appIDClass ? appIDClass : "";
 }
 
 void CHyprXWaylandManager::sendCloseWindow(CWindow* pWindow) {
@@ -2,6 +2,7 @@
 
 #include "../defines.hpp"
 #include "../Window.hpp"
+#include <string_view>
 
 class CHyprXWaylandManager {
 public:
@@ -16,6 +17,8 @@ public:
     void                getGeometryForWindow(CWindow*, wlr_box*);
     std::string         getTitle(CWindow*);
     std::string         getAppIDClass(CWindow*);
+    // points into the surface, valid until the client changes it
+    std::string_view    getAppIDClassView(CWindow*);
     void                sendCloseWindow(CWindow*);
     void                setWindowSize(CWindow*, const Vector2D&);
     void                setWindowStyleTiled(CWindow*, uint32_t);
@@ -0,0 +1,190 @@
+#include "FramePrep.hpp"
+#include "../helpers/MiscFunctions.hpp"
+
+#include <chrono>
+
+// sums up how many pixels a region covers
+static long regionArea(pixman_region32_t* pRegion) {
+    long area = 0;
+    int rectsNum = 0;
+    const auto RECTSARR = pixman_region32_rectangles(pRegion, &rectsNum);
+
+    for (int i = 0; i < rectsNum; ++i)
+        area += (long)(RECTSARR[i].x2 - RECTSARR[i].x1) * (RECTSARR[i].y2 - RECTSARR[i].y1);
+
+    return area;
+}
+
+// counts towards SFramePrep::workNs for as long as it lives
+struct SPrepWorkTimer {
+    SFramePrep& prep;
+    const std::chrono::steady_clock::time_point BEGIN = std::chrono::steady_clock::now();
+
+    ~SPrepWorkTimer() {
+        prep.workNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - BEGIN).count();
+    }
+};
+
+SFramePrep::SFramePrep() {
+    pixman_region32_init(&damage);
+}
+
+SFramePrep::~SFramePrep() {
+    reset();
+    pixman_region32_fini(&damage);
+}
+
+void SFramePrep::reset() {
+    for (auto& s : surfaces) {
+        pixman_region32_fini(&s.opaque);
+        pixman_region32_fini(&s.opaqueAbove);
+        pixman_region32_fini(&s.visible);
+    }
+
+    surfaces.clear();
+    firstBelowBlurCache = SIZE_MAX;
+    pixman_region32_clear(&damage);
+    expandForBlur = false;
+    fullDamage = false;
+    occlude = false;
+    workNs = 0;
+}
+
+SPrepSurface& SFramePrep::addSurface(void* pOwner) {
+    auto& surface = surfaces.emplace_back();
+    surface.pOwner = pOwner;
+    pixman_region32_init(&surface.opaque);
+    pixman_region32_init(&surface.opaqueAbove);
+    pixman_region32_init(&surface.visible);
+    return surface;
+}
+
+void prepareOpaque(SFramePrep& prep, size_t begin, size_t end) {
+    SPrepWorkTimer timer{prep};
+
+    const bool FRACTIONALSCALE = prep.scale != std::floor(prep.scale);
+
+    for (size_t i = begin; i < end; ++i) {
+        auto& s = prep.surfaces[i];
+
+        if (!s.hasOpaque)
+            continue;
+
+        pixman_region32_translate(&s.opaque, (int)(s.opaquePos.x - prep.monitorPosition.x), (int)(s.opaquePos.y - prep.monitorPosition.y));
+        wlr_region_scale(&s.opaque, &s.opaque, prep.scale);
+
+        // scaling rounds outwards, don't claim edge pixels we only partially cover
+        if (FRACTIONALSCALE)
+            wlr_region_expand(&s.opaque, &s.opaque, -1);
+
+        // rounded corners let through what's below
+        if (s.rounding > 0) {
+            const auto& BOX = s.opaqueBox;
+
+            pixman_region32_t notCorners;
+            pixman_region32_init_rect(&notCorners, BOX.x + s.rounding, BOX.y, std::max(BOX.width - 2 * s.rounding, 0), BOX.height);
+            pixman_region32_union_rect(&notCorners, &notCorners, BOX.x, BOX.y + s.rounding, BOX.width, std::max(BOX.height - 2 * s.rounding, 0));
+            pixman_region32_intersect(&s.opaque, &s.opaque, &notCorners);
+            pixman_region32_fini(&notCorners);
+        }
+    }
+}
+
+void accumulateOpaque(SFramePrep& prep) {
+    SPrepWorkTimer timer{prep};
+
+    // only the surroundings of windows that actually blur need to be redrawn for proper blurring.
+    // include the radius around them too, as the blur samples from there.
+    if (prep.expandForBlur && pixman_region32_not_empty(&prep.damage)) {
+        pixman_region32_t blurRegion;
+        pixman_region32_init(&blurRegion);
+
+        for (auto& s : prep.surfaces) {
+            if (s.blurs)
+                pixman_region32_union_rect(&blurRegion, &blurRegion, s.blurBox.x - prep.blurRadius, s.blurBox.y - prep.blurRadius, s.blurBox.width + 2 * prep.blurRadius,
+                                           s.blurBox.height + 2 * prep.blurRadius);
+        }
+
+        if (pixman_region32_not_empty(&blurRegion)) {
+            pixman_region32_t expanded;
+            pixman_region32_init(&expanded);
+
+            wlr_region_expand(&expanded, &prep.damage, prep.blurRadius);
+            pixman_region32_intersect(&expanded, &expanded, &blurRegion);
+            pixman_region32_union(&prep.damage, &prep.damage, &expanded);
+
+            pixman_region32_fini(&expanded);
+        }
+
+        pixman_region32_fini(&blurRegion);
+    }
+
+    if (prep.fullDamage)
+        pixman_region32_union_rect(&prep.damage, &prep.damage, 0, 0, prep.width, prep.height);
+
+    if (!pixman_region32_not_empty(&prep.damage))
+        prep.occlude = false;
+
+    if (!prep.occlude)
+        return;
+
+    // front to back, what each surface has in front of it is a running union
+    pixman_region32_t opaque;
+    pixman_region32_init(&opaque);
+
+    for (size_t i = 0; i < prep.surfaces.size(); ++i) {
+        auto& s = prep.surfaces[i];
+
+        if (i == prep.firstBelowBlurCache)
+            pixman_region32_clear(&opaque);
+
+        pixman_region32_copy(&s.opaqueAbove, &opaque);
+
+        if (s.blurs) {
+            // blur samples what's below it, radius included, so that has to be drawn
+            pixman_region32_t blurArea;
+            pixman_region32_init_rect(&blurArea, s.blurBox.x - prep.blurRadius, s.blurBox.y - prep.blurRadius, s.blurBox.width + 2 * prep.blurRadius,
+                                      s.blurBox.height + 2 * prep.blurRadius);
+            pixman_region32_subtract(&opaque, &opaque, &blurArea);
+            pixman_region32_fini(&blurArea);
+        } else if (s.hasOpaque)
+            pixman_region32_union(&opaque, &opaque, &s.opaque);
+    }
+
+    pixman_region32_fini(&opaque);
+}
+
+void clipDamage(SFramePrep& prep, size_t begin, size_t end) {
+    if (!prep.occlude)
+        return;
+
+    SPrepWorkTimer timer{prep};
+
+    for (size_t i = begin; i < end; ++i) {
+        auto& s = prep.surfaces[i];
+
+        pixman_region32_subtract(&s.visible, &prep.damage, &s.opaqueAbove);
+
+        pixman_region32_t damageBefore, damageAfter;
+        pixman_region32_init_rect(&damageBefore, s.box.x, s.box.y, s.box.width, s.box.height);
+        pixman_region32_init_rect(&damageAfter, s.box.x, s.box.y, s.box.width, s.box.height);
+        pixman_region32_intersect(&damageBefore, &damageBefore, &prep.damage);
+        pixman_region32_intersect(&damageAfter, &damageAfter, &s.visible);
+
+        s.pixelsOccluded = regionArea(&damageBefore) - regionArea(&damageAfter);
+
+        if (s.canCull && !pixman_region32_not_empty(&damageAfter)) {
+            s.culled = pixman_region32_not_empty(&damageBefore);
+            pixman_region32_clear(&s.visible);
+        }
+
+        pixman_region32_fini(&damageBefore);
+        pixman_region32_fini(&damageAfter);
+    }
+}
+
+void prepareFrame(SFramePrep& prep) {
+    prepareOpaque(prep, 0, prep.surfaces.size());
+    accumulateOpaque(prep);
+    clipDamage(prep, 0, prep.surfaces.size());
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <atomic>
+#include <vector>
+
+// The region math of a frame: the damage grown around blurring windows, and what's left of it per surface once
+// everything opaque in front is cut out. CHyprRenderer::beginFramePrep copies what it needs out of the windows,
+// layers and wlr_surfaces on the main thread, so that none of this looks at compositor or wlroots state and can
+// run on the worker pool. All boxes and regions are monitor-local and scaled, like the damage.
+
+// a surface drawn on the monitor
+struct SPrepSurface {
+    void*             pOwner = nullptr;   // the window, layer or monitor (its clear) the result is looked up by
+    wlr_box           box = {0, 0, 0, 0}; // everything it draws, subsurfaces included
+    bool              canCull = true;     // popups go wherever they want, a surface with them is never skipped
+
+    // samples what's below blurBox, blur radius included, so nothing in front may hide that
+    bool              blurs = false;
+    wlr_box           blurBox = {0, 0, 0, 0};
+
+    // what it covers for good. Snapshotted surface-local at opaquePos (layout coords), prepareOpaque brings it here.
+    bool              hasOpaque = false;
+    pixman_region32_t opaque;
+    Vector2D          opaquePos;
+    wlr_box           opaqueBox = {0, 0, 0, 0}; // the surface, for its rounded corners
+    int               rounding = 0;           // scaled px
+
+    // results
+    pixman_region32_t opaqueAbove;        // everything opaque in front of it
+    pixman_region32_t visible;            // the frame damage minus opaqueAbove, empty if none of its box is left
+    long              pixelsOccluded = 0; // damaged pixels of its box that something covers
+    bool              culled = false;     // damaged, but all of it is covered
+};
+
+struct SFramePrep {
+    SFramePrep();
+    ~SFramePrep();
+
+    SFramePrep(const SFramePrep&) = delete;
+    SFramePrep& operator=(const SFramePrep&) = delete;
+
+    // drops the surfaces of the last frame
+    void                      reset();
+    // a new surface behind the ones added so far, regions initialized
+    SPrepSurface&             addSurface(void* pOwner);
+
+    // the monitor
+    Vector2D                  monitorPosition;
+    float                     scale = 1.f;
+    int                       width = 0; // transformed size
+    int                       height = 0;
+
+    // front to back
+    std::vector<SPrepSurface> surfaces;
+    // the static blur cache is made from everything from here on, so nothing in front of it may cut into it
+    size_t                    firstBelowBlurCache = SIZE_MAX;
+
+    // in: what the output needs redrawn, out: what will be
+    pixman_region32_t         damage;
+    bool                      expandForBlur = false; // around the surfaces that blur
+    bool                      fullDamage = false;    // the whole monitor, e.g. for the blur cache
+    int                       blurRadius = 0;
+    bool                      occlude = false;       // cleared by accumulateOpaque if the damage ends up empty
+
+    // the region math of this frame summed over the threads that did it, to hold against the wall time
+    std::atomic<long>         workNs = 0;
+};
+
+// per surface, independent of each other: brings the snapshotted opaque regions of surfaces [begin, end) to the monitor
+void prepareOpaque(SFramePrep&, size_t begin, size_t end);
+// on one thread: the final damage, and what's opaque in front of each surface
+void accumulateOpaque(SFramePrep&);
+// per surface, independent of each other: clips the damage of surfaces [begin, end) to what's visible
+void clipDamage(SFramePrep&, size_t begin, size_t end);
+// all of the above on the calling thread
+void prepareFrame(SFramePrep&);
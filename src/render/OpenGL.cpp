@@ -25,55 +25,12 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() {
 
     // Init shaders
 
-    GLuint prog = createProgram(QUADVERTSRC, QUADFRAGSRC);
-    m_shQUAD.program = prog;
-    m_shQUAD.proj = glGetUniformLocation(prog, "proj");
-    m_shQUAD.color = glGetUniformLocation(prog, "color");
-    m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shQUAD.texAttrib = glGetAttribLocation(prog, "texcoord");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCRGBA);
-    m_shRGBA.program = prog;
-    m_shRGBA.proj = glGetUniformLocation(prog, "proj");
-    m_shRGBA.tex = glGetUniformLocation(prog, "tex");
-    m_shRGBA.alpha = glGetUniformLocation(prog, "alpha");
-    m_shRGBA.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shRGBA.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shRGBA.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCRGBX);
-    m_shRGBX.program = prog;
-    m_shRGBX.tex = glGetUniformLocation(prog, "tex");
-    m_shRGBX.proj = glGetUniformLocation(prog, "proj");
-    m_shRGBX.alpha = glGetUniformLocation(prog, "alpha");
-    m_shRGBX.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shRGBX.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shRGBX.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCEXT);
-    m_shEXT.program = prog;
-    m_shEXT.tex = glGetUniformLocation(prog, "tex");
-    m_shEXT.proj = glGetUniformLocation(prog, "proj");
-    m_shEXT.alpha = glGetUniformLocation(prog, "alpha");
-    m_shEXT.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shEXT.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shEXT.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, FRAGBLUR1);
-    m_shBLUR1.program = prog;
-    m_shBLUR1.tex = glGetUniformLocation(prog, "tex");
-    m_shBLUR1.alpha = glGetUniformLocation(prog, "alpha");
-    m_shBLUR1.proj = glGetUniformLocation(prog, "proj");
-    m_shBLUR1.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shBLUR1.texAttrib = glGetAttribLocation(prog, "texcoord");
-
-    prog = createProgram(TEXVERTSRC, FRAGBLUR2);
-    m_shBLUR2.program = prog;
-    m_shBLUR2.tex = glGetUniformLocation(prog, "tex");
-    m_shBLUR2.alpha = glGetUniformLocation(prog, "alpha");
-    m_shBLUR2.proj = glGetUniformLocation(prog, "proj");
-    m_shBLUR2.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shBLUR2.texAttrib = glGetAttribLocation(prog, "texcoord");
+    m_shQUAD.reflect(createProgram(QUADVERTSRC, QUADFRAGSRC));
+    m_shRGBA.reflect(createProgram(TEXVERTSRC, TEXFRAGSRCRGBA));
+    m_shRGBX.reflect(createProgram(TEXVERTSRC, TEXFRAGSRCRGBX));
+    m_shEXT.reflect(createProgram(TEXVERTSRC, TEXFRAGSRCEXT));
+    m_shBLUR1.reflect(createProgram(TEXVERTSRC, FRAGBLUR1));
+    m_shBLUR2.reflect(createProgram(TEXVERTSRC, FRAGBLUR2));
 
     Debug::log(LOG, "Shaders initialized successfully.");
 
@@ -145,13 +102,13 @@ void CHyprOpenGLImpl::begin(SMonitor* pMonitor, pixman_region32_t* pDamage, bool
 
         m_mMonitorRenderResources[pMonitor].primaryFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
         m_mMonitorRenderResources[pMonitor].mirrorFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
-        m_mMonitorRenderResources[pMonitor].mirrorSwapFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
 
         m_mMonitorRenderResources[pMonitor].primaryFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
         m_mMonitorRenderResources[pMonitor].mirrorFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
-        m_mMonitorRenderResources[pMonitor].mirrorSwapFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
 
         createBGTextureForMonitor(pMonitor);
+
+        m_mMonitorRenderResources[pMonitor].blurFBDirty = true;
     }
 
     // bind the primary Hypr Framebuffer
@@ -160,6 +117,9 @@ void CHyprOpenGLImpl::begin(SMonitor* pMonitor, pixman_region32_t* pDamage, bool
     m_RenderData.pDamage = pDamage;
 
     m_bFakeFrame = fake;
+
+    if (!fake)
+        m_sFrameStats = SFrameRenderStats();
 }
 
 void CHyprOpenGLImpl::end() {
@@ -243,6 +203,17 @@ void CHyprOpenGLImpl::renderRect(wlr_box* box, const CColor& col, int round) {
     RASSERT((box->width > 0 && box->height > 0), "Tried to render rect with width/height < 0!");
     RASSERT(m_RenderData.pMonitor, "Tried to render rect without begin()!");
 
+    // only the damage inside of the rect is worth a draw call
+    pixman_region32_t damageClip;
+    pixman_region32_init(&damageClip);
+    pixman_region32_intersect_rect(&damageClip, m_RenderData.pDamage, box->x, box->y, box->width, box->height);
+
+    if (!pixman_region32_not_empty(&damageClip)) {
+        pixman_region32_fini(&damageClip);
+        m_sFrameStats.quadsSkipped++;
+        return;
+    }
+
     float matrix[9];
     wlr_matrix_project_box(matrix, box, wlr_output_transform_invert(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform), 0, m_RenderData.pMonitor->output->transform_matrix);  // TODO: write own, don't use WLR here
 
@@ -257,8 +228,8 @@ void CHyprOpenGLImpl::renderRect(wlr_box* box, const CColor& col, int round) {
 
     glUseProgram(m_shQUAD.program);
 
-    glUniformMatrix3fv(m_shQUAD.proj, 1, GL_FALSE, glMatrix);
-    glUniform4f(m_shQUAD.color, col.r / 255.f, col.g / 255.f, col.b / 255.f, col.a / 255.f);
+    m_shQUAD.setUniformMatrix3fv(m_shQUAD.proj, glMatrix);
+    m_shQUAD.setUniform4f(m_shQUAD.color, col.r / 255.f, col.g / 255.f, col.b / 255.f, col.a / 255.f);
 
     const auto TOPLEFT = Vector2D(round, round);
     const auto BOTTOMRIGHT = Vector2D(box->width - round, box->height - round);
@@ -267,11 +238,11 @@ void CHyprOpenGLImpl::renderRect(wlr_box* box, const CColor& col, int round) {
     static auto *const PMULTISAMPLEEDGES = &g_pConfigManager->getConfigValuePtr("decoration:multisample_edges")->intValue;
 
     // Rounded corners
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "topLeft"), (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "bottomRight"), (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "fullSize"), (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(glGetUniformLocation(m_shQUAD.program, "radius"), round);
-    glUniform1i(glGetUniformLocation(m_shQUAD.program, "primitiveMultisample"), (int)(*PMULTISAMPLEEDGES == 1 && round != 0));
+    m_shQUAD.setUniform2f(m_shQUAD.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    m_shQUAD.setUniform2f(m_shQUAD.bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
+    m_shQUAD.setUniform2f(m_shQUAD.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    m_shQUAD.setUniform1f(m_shQUAD.radius, round);
+    m_shQUAD.setUniform1i(m_shQUAD.primitiveMultisample, (int)(*PMULTISAMPLEEDGES == 1 && round != 0));
 
     glVertexAttribPointer(m_shQUAD.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(m_shQUAD.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -279,17 +250,18 @@ void CHyprOpenGLImpl::renderRect(wlr_box* box, const CColor& col, int round) {
     glEnableVertexAttribArray(m_shQUAD.posAttrib);
     glEnableVertexAttribArray(m_shQUAD.texAttrib);
 
-    if (pixman_region32_not_empty(m_RenderData.pDamage)) {
-        PIXMAN_DAMAGE_FOREACH(m_RenderData.pDamage) {
-            const auto RECT = RECTSARR[i];
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
+    PIXMAN_DAMAGE_FOREACH(&damageClip) {
+        const auto RECT = RECTSARR[i];
+        scissor(&RECT);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_sFrameStats.drawCalls++;
     }
 
     glDisableVertexAttribArray(m_shQUAD.posAttrib);
     glDisableVertexAttribArray(m_shQUAD.texAttrib);
 
+    pixman_region32_fini(&damageClip);
+
     glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 }
 
@@ -311,6 +283,20 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
     RASSERT(m_RenderData.pMonitor, "Tried to render texture without begin()!");
     RASSERT((tex.m_iTexID > 0), "Attempted to draw NULL texture!");
 
+    // only the damage inside of the box is worth a draw call.
+    // with a border we still have to go through the stencil setup, the border lies outside of the box.
+    pixman_region32_t damageClip;
+    pixman_region32_init(&damageClip);
+    pixman_region32_intersect_rect(&damageClip, m_RenderData.pDamage, pBox->x, pBox->y, pBox->width, pBox->height);
+    if (damage != m_RenderData.pDamage)
+        pixman_region32_intersect(&damageClip, &damageClip, damage);
+
+    if (!border && !pixman_region32_not_empty(&damageClip)) {
+        pixman_region32_fini(&damageClip);
+        m_sFrameStats.quadsSkipped++;
+        return;
+    }
+
     // get transform
     const auto TRANSFORM = wlr_output_transform_invert(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform);
     float matrix[9];
@@ -348,10 +334,10 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
 
     glUseProgram(shader->program);
 
-    glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix);
-    glUniform1i(shader->tex, 0);
-    glUniform1f(shader->alpha, alpha / 255.f);
-    glUniform1i(shader->discardOpaque, (int)discardOpaque);
+    shader->setUniformMatrix3fv(shader->proj, glMatrix);
+    shader->setUniform1i(shader->tex, 0);
+    shader->setUniform1f(shader->alpha, alpha / 255.f);
+    shader->setUniform1i(shader->discardOpaque, (int)discardOpaque);
 
     // round is in px
     // so we need to do some maf
@@ -362,11 +348,11 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
     static auto *const PMULTISAMPLEEDGES = &g_pConfigManager->getConfigValuePtr("decoration:multisample_edges")->intValue;
 
     // Rounded corners
-    glUniform2f(glGetUniformLocation(shader->program, "topLeft"), (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(glGetUniformLocation(shader->program, "bottomRight"), (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(glGetUniformLocation(shader->program, "fullSize"), (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(glGetUniformLocation(shader->program, "radius"), round);
-    glUniform1i(glGetUniformLocation(shader->program, "primitiveMultisample"), (int)(*PMULTISAMPLEEDGES == 1 && round != 0 && !border && !noAA));
+    shader->setUniform2f(shader->topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    shader->setUniform2f(shader->bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
+    shader->setUniform2f(shader->fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    shader->setUniform1f(shader->radius, round);
+    shader->setUniform1i(shader->primitiveMultisample, (int)(*PMULTISAMPLEEDGES == 1 && round != 0 && !border && !noAA));
 
     glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(shader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -385,14 +371,15 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
         glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
     }
 
-    if (pixman_region32_not_empty(m_RenderData.pDamage)) {
-        PIXMAN_DAMAGE_FOREACH(m_RenderData.pDamage) {
-            const auto RECT = RECTSARR[i];
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
+    PIXMAN_DAMAGE_FOREACH(&damageClip) {
+        const auto RECT = RECTSARR[i];
+        scissor(&RECT);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_sFrameStats.drawCalls++;
     }
 
+    pixman_region32_fini(&damageClip);
+
     if (border) {
         glStencilFunc(GL_EQUAL, 1, -1);
         glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
@@ -447,35 +434,56 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
     pixman_region32_copy(&damage, originalDamage);
     wlr_region_expand(&damage, &damage, pow(2, *PBLURPASSES) * *PBLURSIZE);
 
-    // helper
-    const auto PMIRRORFB = &m_mMonitorRenderResources[m_RenderData.pMonitor].mirrorFB;
-    const auto PMIRRORSWAPFB = &m_mMonitorRenderResources[m_RenderData.pMonitor].mirrorSwapFB;
+    // the chain: primaryFB -> 1/2 -> 1/4 -> ... down, then back up level by level, the last pass lands in mirrorFB
+    const auto PRENDERDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+    const auto PMIRRORFB = &PRENDERDATA->mirrorFB;
+    const int  PASSES = std::max(1, (int)*PBLURPASSES);
+
+    for (size_t i = PASSES; i < PRENDERDATA->blurMipFBs.size(); ++i)
+        PRENDERDATA->blurMipFBs[i].release();
+
+    PRENDERDATA->blurMipFBs.resize(PASSES);
+
+    for (int i = 0; i < PASSES; ++i) {
+        const auto LEVELSIZE = Vector2D(std::ceil(m_RenderData.pMonitor->vecPixelSize.x / (1 << (i + 1))), std::ceil(m_RenderData.pMonitor->vecPixelSize.y / (1 << (i + 1))));
+
+        if (PRENDERDATA->blurMipFBs[i].m_Size != LEVELSIZE || PRENDERDATA->blurMipFBs[i].m_cTex.m_iTexID == 0)
+            PRENDERDATA->blurMipFBs[i].alloc(LEVELSIZE.x, LEVELSIZE.y);
+    }
+
+    const auto LEVELFB = [&](int level) { return level == 0 ? PMIRRORFB : &PRENDERDATA->blurMipFBs[level - 1]; };
+
+    // like scissor(), but against the size of the level we render to
+    const auto SCISSORLEVEL = [&](const pixman_box32_t& rect, const Vector2D& levelSize) {
+        wlr_box box = {rect.x1, rect.y1, rect.x2 - rect.x1, rect.y2 - rect.y1};
+
+        const bool ROTATED = m_RenderData.pMonitor->transform % 2 == 1;
+        wlr_box_transform(&box, &box, wlr_output_transform_invert(m_RenderData.pMonitor->transform), ROTATED ? levelSize.y : levelSize.x, ROTATED ? levelSize.x : levelSize.y);
 
-    CFramebuffer* currentRenderToFB = &m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB;
+        glScissor(box.x, box.y, box.width, box.height);
+        glEnable(GL_SCISSOR_TEST);
+    };
 
     // declare the draw func
-    auto drawPass = [&](CShader* pShader, pixman_region32_t* pDamage) {
-        if (currentRenderToFB == PMIRRORFB)
-            PMIRRORSWAPFB->bind();
-        else
-            PMIRRORFB->bind();
+    auto drawPass = [&](CShader* pShader, CFramebuffer* pSource, CFramebuffer* pTarget, pixman_region32_t* pDamage) {
+        pTarget->bind();
 
         glActiveTexture(GL_TEXTURE0);
 
-        glBindTexture(currentRenderToFB->m_cTex.m_iTarget, currentRenderToFB->m_cTex.m_iTexID);
+        glBindTexture(pSource->m_cTex.m_iTarget, pSource->m_cTex.m_iTexID);
 
-        glTexParameteri(currentRenderToFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(pSource->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
         glUseProgram(pShader->program);
 
-        // prep two shaders
-        glUniformMatrix3fv(pShader->proj, 1, GL_FALSE, glMatrix);
-        glUniform1f(glGetUniformLocation(pShader->program, "radius"), *PBLURSIZE * (a / 255.f));  // this makes the blursize change with a
+        // prep two shaders, the offsets are in texels of the level we sample
+        pShader->setUniformMatrix3fv(pShader->proj, glMatrix);
+        pShader->setUniform1f(pShader->radius, *PBLURSIZE * (a / 255.f));  // this makes the blursize change with a
         if (pShader == &m_shBLUR1)
-            glUniform2f(glGetUniformLocation(m_shBLUR1.program, "halfpixel"), 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
+            pShader->setUniform2f(pShader->halfpixel, 0.5f / (pSource->m_Size.x / 2.f), 0.5f / (pSource->m_Size.y / 2.f));
         else
-            glUniform2f(glGetUniformLocation(m_shBLUR2.program, "halfpixel"), 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
-        glUniform1i(pShader->tex, 0);
+            pShader->setUniform2f(pShader->halfpixel, 0.5f / (pSource->m_Size.x * 2.f), 0.5f / (pSource->m_Size.y * 2.f));
+        pShader->setUniform1i(pShader->tex, 0);
 
         glVertexAttribPointer(pShader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
         glVertexAttribPointer(pShader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -486,44 +494,38 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
         if (pixman_region32_not_empty(pDamage)) {
             PIXMAN_DAMAGE_FOREACH(pDamage) {
                 const auto RECT = RECTSARR[i];
-                scissor(&RECT);
+                SCISSORLEVEL(RECT, pTarget->m_Size);
 
                 glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                m_sFrameStats.drawCalls++;
+                m_sFrameStats.blurPixels += (long)(RECT.x2 - RECT.x1) * (RECT.y2 - RECT.y1);
             }
         }
 
+        m_sFrameStats.blurPasses++;
+
         glDisableVertexAttribArray(pShader->posAttrib);
         glDisableVertexAttribArray(pShader->texAttrib);
-
-        if (currentRenderToFB != PMIRRORFB)
-            currentRenderToFB = PMIRRORFB;
-        else
-            currentRenderToFB = PMIRRORSWAPFB;
     };
 
-    // draw the things.
-    // first draw is prim -> mirr
-    PMIRRORFB->bind();
-    glBindTexture(m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTarget, m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTexID);
-
-    // damage region will be scaled, make a temp
+    // damage region will be scaled to each level, make a temp
     pixman_region32_t tempDamage;
     pixman_region32_init(&tempDamage);
-    wlr_region_scale(&tempDamage, &damage, 1.f / 2.f); // when DOWNscaling, we make the region twice as small because it's the TARGET
 
-    drawPass(&m_shBLUR1, &tempDamage);
-
-    // and draw
-    for (int i = 1; i < *PBLURPASSES; ++i) {
-        wlr_region_scale(&tempDamage, &damage, 1.f / (1 << (i + 1)));
-        drawPass(&m_shBLUR1, &tempDamage);  // down
+    // down, primary -> 1/2 -> ... -> 1/2^PASSES
+    for (int i = 1; i <= PASSES; ++i) {
+        wlr_region_scale(&tempDamage, &damage, 1.f / (1 << i)); // the TARGET's size
+        drawPass(&m_shBLUR1, i == 1 ? &PRENDERDATA->primaryFB : LEVELFB(i - 1), LEVELFB(i), &tempDamage);
     }
 
-    for (int i = *PBLURPASSES - 1; i >= 0; --i) {
-        wlr_region_scale(&tempDamage, &damage, 1.f / (1 << i));  // when upsampling we make the region twice as big
-        drawPass(&m_shBLUR2, &tempDamage);  // up
+    // and up, 1/2^PASSES -> ... -> mirrorFB
+    for (int i = PASSES - 1; i >= 0; --i) {
+        wlr_region_scale(&tempDamage, &damage, 1.f / (1 << i));
+        drawPass(&m_shBLUR2, LEVELFB(i + 1), LEVELFB(i), &tempDamage);
     }
 
+    scissor((wlr_box*)nullptr);
+
     // finish
     pixman_region32_fini(&tempDamage);
     pixman_region32_fini(&damage);
@@ -533,7 +535,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
 
     glBindTexture(PMIRRORFB->m_cTex.m_iTarget, 0);
 
-    return currentRenderToFB;
+    return PMIRRORFB;
 }
 
 void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox, float a, wlr_surface* pSurface, int round, bool border) {
@@ -570,7 +572,15 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
     }
 
     // blur the main FB, it will be rendered onto the mirror
-    const auto POUTFB = blurMainFramebufferWithDamage(a, pBox, &inverseOpaque);
+    // or, for windows, use the cached static blur if we can
+    static auto *const PBLURNEWOPTIMIZE = &g_pConfigManager->getConfigValuePtr("decoration:blur_new_optimizations")->intValue;
+    const auto PRENDERDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+
+    CFramebuffer* POUTFB = nullptr;
+    if (*PBLURNEWOPTIMIZE && m_pCurrentWindow && !PRENDERDATA->blurFBDirty && PRENDERDATA->blurFB.m_cTex.m_iTexID)
+        POUTFB = &PRENDERDATA->blurFB;
+    else
+        POUTFB = blurMainFramebufferWithDamage(a, pBox, &inverseOpaque);
 
     pixman_region32_fini(&inverseOpaque);
 
@@ -684,12 +694,13 @@ void CHyprOpenGLImpl::makeWindowSnapshot(CWindow* pWindow) {
     // will try to copy the bg to apply blur.
     // this isn't entirely correct, but like, oh well.
     // small todo: maybe make this correct? :P
-    const auto BLURVAL = g_pConfigManager->getInt("decoration:blur");
-    g_pConfigManager->setInt("decoration:blur", 0);
+    static auto *const PBLUR = &g_pConfigManager->getConfigValuePtr("decoration:blur")->intValue;
+    const auto BLURVAL = *PBLUR;
+    *PBLUR = 0;
 
     g_pHyprRenderer->renderWindow(pWindow, PMONITOR, &now, !pWindow->m_bX11DoesntWantBorders);
 
-    g_pConfigManager->setInt("decoration:blur", BLURVAL);
+    *PBLUR = BLURVAL;
 
     // render onto the window fb
     // we rendered onto the primary because it has a stencil, which we need for the borders etc
@@ -883,9 +894,67 @@ void CHyprOpenGLImpl::clearWithTex() {
     renderTexture(m_mMonitorBGTextures[m_RenderData.pMonitor], &box, 255, 0);
 }
 
+void CHyprOpenGLImpl::markBlurDirtyForMonitor(SMonitor* pMonitor) {
+    m_mMonitorRenderResources[pMonitor].blurFBDirty = true;
+}
+
+bool CHyprOpenGLImpl::preRender(SMonitor* pMonitor) {
+    static auto *const PBLURENABLED = &g_pConfigManager->getConfigValuePtr("decoration:blur")->intValue;
+    static auto *const PBLURNEWOPTIMIZE = &g_pConfigManager->getConfigValuePtr("decoration:blur_new_optimizations")->intValue;
+
+    const auto PRENDERDATA = &m_mMonitorRenderResources[pMonitor];
+
+    if (!*PBLURENABLED || !*PBLURNEWOPTIMIZE || !PRENDERDATA->blurFBDirty)
+        return false;
+
+    // nothing would sample it, don't bother until something will
+    if (g_pCompositor->getWindowsOnWorkspace(pMonitor->activeWorkspace) == 0 && !pMonitor->specialWorkspaceOpen)
+        return false;
+
+    PRENDERDATA->blurFBShouldRender = true;
+    PRENDERDATA->blurFBDirty = false; // anything marking it during this frame will trigger another pass on the next one
+
+    // the static layers have to be redrawn on the whole monitor for the cache, so the caller needs to damage it all
+    return true;
+}
+
+void CHyprOpenGLImpl::preBlurForCurrentMonitor() {
+    RASSERT(m_RenderData.pMonitor, "Tried to preblur without begin()!");
+
+    const auto PRENDERDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+
+    if (!PRENDERDATA->blurFBShouldRender)
+        return;
+
+    // primaryFB holds only the wallpaper and the background / bottom layers right now, blur all of it
+    wlr_box wholeMonitor = {0, 0, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y};
+
+    pixman_region32_t fakeDamage;
+    pixman_region32_init_rect(&fakeDamage, 0, 0, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y);
+
+    const auto POUTFB = blurMainFramebufferWithDamage(255.f, &wholeMonitor, &fakeDamage);
+
+    // and keep it
+    PRENDERDATA->blurFB.alloc(m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
+    PRENDERDATA->blurFB.bind();
+
+    clear(CColor(0, 0, 0, 0));
+
+    renderTextureInternalWithDamage(POUTFB->m_cTex, &wholeMonitor, 255.f, &fakeDamage, 0, false, false, true);
+
+    pixman_region32_fini(&fakeDamage);
+
+    PRENDERDATA->primaryFB.bind();
+
+    PRENDERDATA->blurFBShouldRender = false;
+}
+
 void CHyprOpenGLImpl::destroyMonitorResources(SMonitor* pMonitor) {
     g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].mirrorFB.release();
+    g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].blurFB.release();
     g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].primaryFB.release();
+    for (auto& fb : g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].blurMipFBs)
+        fb.release();
     g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].stencilTex.destroyTexture();
     g_pHyprOpenGL->m_mMonitorBGTextures[pMonitor].destroyTexture();
     g_pHyprOpenGL->m_mMonitorRenderResources.erase(pMonitor);
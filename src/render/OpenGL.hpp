@@ -5,6 +5,7 @@
 #include "../helpers/Color.hpp"
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "Shaders.hpp"
 #include "Shader.hpp"
@@ -36,10 +37,36 @@ struct SCurrentRenderData {
     pixman_region32_t* pDamage = nullptr;
 };
 
+// reset on every non-fake begin(), read by the debug overlay
+struct SFrameRenderStats {
+    int drawCalls = 0;
+    int quadsSkipped = 0; // quads with no damage inside of their box
+    int uniformUploads = 0;
+    int uniformUploadsAvoided = 0; // value was already set on the program
+    int blurPasses = 0;
+    long blurPixels = 0; // pixels processed over all blur passes
+    int surfacesCulled = 0; // damaged surfaces fully behind opaque ones
+    long pixelsOccluded = 0; // damaged pixels not drawn because something opaque covers them
+    float framePrepWorkUs = 0; // the frame prep's region math, summed over the threads that did it
+    int framePrepThreads = 0; // workers, the main thread helps out on top
+    int renderListItems = 0;
+    bool renderListRebuilt = false; // or reused from the last frame
+    float renderListBuildTimeUs = 0; // of its last rebuild
+    int damageRectsRaw = 0; // damaged boxes that hit the monitor since its last frame
+    int damageRectsMerged = 0; // rects handed to the output after merging those
+};
+
 struct SMonitorRenderData {
     CFramebuffer primaryFB;
     CFramebuffer mirrorFB;
-    CFramebuffer mirrorSwapFB;
+
+    // 1/2, 1/4, ... of the monitor, one per blur pass, allocated by the first blur
+    std::vector<CFramebuffer> blurMipFBs;
+
+    // cached blur of the wallpaper and the background / bottom layers, for decoration:blur_new_optimizations
+    CFramebuffer blurFB;
+    bool         blurFBDirty = true;
+    bool         blurFBShouldRender = false;
 
     CTexture     stencilTex;
 };
@@ -70,7 +97,12 @@ public:
 
     void    destroyMonitorResources(SMonitor*);
 
+    void    markBlurDirtyForMonitor(SMonitor*);
+    bool    preRender(SMonitor*);
+    void    preBlurForCurrentMonitor();
+
     SCurrentRenderData m_RenderData;
+    SFrameRenderStats  m_sFrameStats;
 
     GLint  m_iCurrentOutputFb = 0;
     GLint  m_iWLROutputFb = 0;
@@ -95,7 +127,7 @@ private:
     bool                    m_bEndFrame = false;
 
     // Shaders
-    SQuad                   m_shQUAD;
+    CShader                 m_shQUAD;
     CShader                 m_shRGBA;
     CShader                 m_shRGBX;
     CShader                 m_shEXT;
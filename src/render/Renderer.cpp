@@ -39,7 +39,11 @@ bool CHyprRenderer::shouldRenderWindow(CWindow* pWindow, SMonitor* pMonitor) {
     if (!wlr_output_layout_intersects(g_pCompositor->m_sWLROutputLayout, pMonitor->output, &geometry))
         return false;
 
-    // now check if it has the same workspace
+    return shouldRenderWorkspaceOf(pWindow, pMonitor);
+}
+
+bool CHyprRenderer::shouldRenderWorkspaceOf(CWindow* pWindow, SMonitor* pMonitor) {
+    // check if it has the same workspace
     if (pWindow->m_iWorkspaceID == pMonitor->activeWorkspace)
         return true;
 
@@ -75,40 +79,496 @@ bool CHyprRenderer::shouldRenderWindow(CWindow* pWindow) {
     return false;
 }
 
-void CHyprRenderer::renderWorkspaceWithFullscreenWindow(SMonitor* pMonitor, CWorkspace* pWorkspace, timespec* time) {
-    CWindow* pWorkspaceWindow = nullptr;
+float CHyprRenderer::getWindowOpacity(CWindow* pWindow) {
+    static auto *const PACTIVEALPHA = &g_pConfigManager->getConfigValuePtr("decoration:active_opacity")->floatValue;
+    static auto *const PINACTIVEALPHA = &g_pConfigManager->getConfigValuePtr("decoration:inactive_opacity")->floatValue;
+    static auto *const PFULLSCREENALPHA = &g_pConfigManager->getConfigValuePtr("decoration:fullscreen_opacity")->floatValue;
+
+    const bool ACTIVE = pWindow == g_pCompositor->m_pLastWindow;
+
+    float alpha = pWindow->m_bIsFullscreen ? *PFULLSCREENALPHA : ACTIVE ? *PACTIVEALPHA : *PINACTIVEALPHA;
+
+    // apply window special data
+    if (pWindow->m_sSpecialRenderData.alphaInactive == -1)
+        alpha *= pWindow->m_sSpecialRenderData.alpha;
+    else
+        alpha *= ACTIVE ? pWindow->m_sSpecialRenderData.alpha : pWindow->m_sSpecialRenderData.alphaInactive;
+
+    return alpha;
+}
+
+bool CHyprRenderer::windowNeedsBlur(CWindow* pWindow) {
+    const auto PSURFACE = g_pXWaylandManager->getWindowSurface(pWindow);
+
+    if (!PSURFACE)
+        return false;
+
+    // anything not fully opaque shows (and blurs) what's behind it
+    if (pWindow->m_fAlpha.fl() != 255.f || pWindow->m_bFadingOut)
+        return true;
+
+    if (getWindowOpacity(pWindow) < 1.f)
+        return true;
+
+    pixman_box32_t surfaceBox = {0, 0, PSURFACE->current.width, PSURFACE->current.height};
+    return pixman_region32_contains_rectangle(&PSURFACE->current.opaque, &surfaceBox) != PIXMAN_REGION_IN;
+}
+
+// the monitor in layout coords. vecSize is floored, at fractional scales that would cut off the last row and column
+// of pixels, so this rounds the unfloored size up instead.
+static wlr_box monitorLayoutBox(const SMonitor& monitor) {
+    return {(int)monitor.vecPosition.x, (int)monitor.vecPosition.y, (int)std::ceil(monitor.vecTransformedSize.x / monitor.scale), (int)std::ceil(monitor.vecTransformedSize.y / monitor.scale)};
+}
+
+static void sendFrameDone(wlr_surface* surface, int x, int y, void* data) {
+    wlr_surface_send_frame_done(surface, (timespec*)data);
+}
+
+// surfaces per task on the frame prep pool, fewer aren't worth waking a thread for
+constexpr size_t FRAMEPREP_SURFACES_PER_TASK = 8;
+constexpr int    FRAMEPREP_MAX_THREADS       = 4;
+
+CHyprRenderer::CHyprRenderer() {
+    // the main thread helps out while it waits, so one less
+    const int THREADS = std::clamp((int)std::thread::hardware_concurrency() - 1, 0, FRAMEPREP_MAX_THREADS);
+    m_pFramePrepPool = std::make_unique<CWorkerPool>(THREADS);
+
+    Debug::log(LOG, "Frame prep runs on %d worker threads", THREADS);
+}
+
+static void dispatchPerSurface(CWorkerPool* pPool, SFramePrep& prep, void (*fn)(SFramePrep&, size_t, size_t)) {
+    const size_t SURFACES = prep.surfaces.size();
+    const size_t TASKS = (SURFACES + FRAMEPREP_SURFACES_PER_TASK - 1) / FRAMEPREP_SURFACES_PER_TASK;
+
+    pPool->dispatch(TASKS, [&prep, fn, SURFACES](size_t task) { fn(prep, task * FRAMEPREP_SURFACES_PER_TASK, std::min(SURFACES, (task + 1) * FRAMEPREP_SURFACES_PER_TASK)); });
+}
+
+void CHyprRenderer::beginFramePrep(SMonitor* pMonitor, pixman_region32_t* pDamage, bool expandForBlur) {
+    static auto *const PROUNDING = &g_pConfigManager->getConfigValuePtr("decoration:rounding")->intValue;
+    static auto *const PBLURENABLED = &g_pConfigManager->getConfigValuePtr("decoration:blur")->intValue;
+    static auto *const PBLURSIZE = &g_pConfigManager->getConfigValuePtr("decoration:blur_size")->intValue;
+    static auto *const PBLURPASSES = &g_pConfigManager->getConfigValuePtr("decoration:blur_passes")->intValue;
+    static auto *const PBLURNEWOPTIMIZE = &g_pConfigManager->getConfigValuePtr("decoration:blur_new_optimizations")->intValue;
+
+    clearOcclusion();
+
+    auto& prep = m_mFramePreps[pMonitor];
+    prep.reset();
+
+    prep.monitorPosition = pMonitor->vecPosition;
+    prep.scale = pMonitor->scale;
+    prep.width = (int)pMonitor->vecTransformedSize.x;
+    prep.height = (int)pMonitor->vecTransformedSize.y;
+    prep.blurRadius = *PBLURSIZE * pow(2, *PBLURPASSES); // is this 2^pass? I don't know but it works... I think.
+    pixman_region32_copy(&prep.damage, pDamage);
+
+    // windows sample the cached static blur, which doesn't care about damage around them.
+    // if the cache is dirty the whole monitor gets redrawn anyways.
+    prep.expandForBlur = expandForBlur && *PBLURENABLED == 1 && !(*PBLURNEWOPTIMIZE && !g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].blurFBDirty);
+
+    // the static blur cache needs the whole monitor redrawn
+    prep.fullDamage = g_pHyprOpenGL->preRender(pMonitor);
+
+    // the fullscreen path draws next to nothing below the fullscreen window anyways
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace);
+    prep.occlude = PWORKSPACE && !PWORKSPACE->m_bHasFullscreenWindow;
+
+    // layout -> monitor-local scaled
+    const auto TOMONITOR = [&](wlr_box box) {
+        box.x -= pMonitor->vecPosition.x;
+        box.y -= pMonitor->vecPosition.y;
+        scaleBox(&box, pMonitor->scale);
+        return box;
+    };
+
+    // the opaque region of a surface drawn at pos (layout coords), rounding is in scaled px
+    const auto SNAPSHOTOPAQUE = [&](SPrepSurface& surface, wlr_surface* pSurface, const Vector2D& pos, int rounding) {
+        surface.hasOpaque = true;
+        pixman_region32_intersect_rect(&surface.opaque, &pSurface->current.opaque, 0, 0, pSurface->current.width, pSurface->current.height);
+        surface.opaquePos = pos;
+        surface.opaqueBox = TOMONITOR({(int)pos.x, (int)pos.y, pSurface->current.width, pSurface->current.height});
+        surface.rounding = rounding;
+    };
+
+    const auto SNAPSHOTLAYER = [&](SLayerSurface* pLayer) {
+        // a fading out one is only its snapshot
+        if (pLayer->fadingOut) {
+            prep.addSurface(pLayer).box = TOMONITOR(pLayer->geometry);
+            return;
+        }
+
+        const auto PSURFACE = pLayer->layerSurface->surface;
+
+        // subsurfaces can stick out
+        wlr_box extents = {0, 0, 0, 0};
+        wlr_surface_get_extends(PSURFACE, &extents);
+
+        auto& surface = prep.addSurface(pLayer);
+        surface.box = TOMONITOR({pLayer->geometry.x + extents.x, pLayer->geometry.y + extents.y, extents.width, extents.height});
+
+        if (pLayer->layerSurface->mapped && pLayer->alpha.fl() == 255.f)
+            SNAPSHOTOPAQUE(surface, PSURFACE, Vector2D(pLayer->geometry.x, pLayer->geometry.y), 0);
+    };
+
+    const auto SNAPSHOTWINDOW = [&](const SRenderListItem& item) {
+        const auto PWINDOW = item.pWindow;
+
+        if (PWINDOW->m_bHidden)
+            return;
+
+        const auto PWINDOWWORKSPACE = g_pCompositor->getWorkspaceByID(PWINDOW->m_iWorkspaceID);
+        const auto REALPOS = item.realPosition;
+        const auto REALSIZE = PWINDOW->m_vRealSize.vec();
+        const auto PSURFACE = PWINDOW->m_bFadingOut ? nullptr : g_pXWaylandManager->getWindowSurface(PWINDOW);
+
+        wlr_box box = item.fullBox;
+
+        if (PSURFACE) {
+            // subsurfaces can stick out
+            wlr_box extents = {0, 0, 0, 0};
+            wlr_surface_get_extends(PSURFACE, &extents);
+
+            const int X1 = std::min(box.x, (int)REALPOS.x + extents.x);
+            const int Y1 = std::min(box.y, (int)REALPOS.y + extents.y);
+            const int X2 = std::max(box.x + box.width, (int)REALPOS.x + extents.x + extents.width);
+            const int Y2 = std::max(box.y + box.height, (int)REALPOS.y + extents.y + extents.height);
+            box = {X1, Y1, X2 - X1, Y2 - Y1};
+        }
+
+        auto& surface = prep.addSurface(PWINDOW);
+        surface.box = TOMONITOR(box);
+
+        // popups go wherever they want, don't skip anything that has them
+        surface.canCull = !(PSURFACE && !PWINDOW->m_bIsX11 && !wl_list_empty(&PWINDOW->m_uSurface.xdg->popups));
+
+        if (*PBLURENABLED && (PWINDOW->m_bFadingOut || windowNeedsBlur(PWINDOW))) {
+            surface.blurs = true;
+            surface.blurBox = TOMONITOR({(int)REALPOS.x, (int)REALPOS.y, (int)REALSIZE.x, (int)REALSIZE.y});
+            return;
+        }
+
+        if (!prep.occlude || !PSURFACE)
+            return;
+
+        const float FADEALPHA = PWINDOW->m_fAlpha.fl() * (PWINDOWWORKSPACE ? PWINDOWWORKSPACE->m_fAlpha.fl() / 255.f : 1.f);
+
+        if (getWindowOpacity(PWINDOW) < 1.f || FADEALPHA < 255.f)
+            return;
+
+        // stretched while resizing, the opaque region won't line up
+        if (PSURFACE->current.width != (int)REALSIZE.x || PSURFACE->current.height != (int)REALSIZE.y)
+            return;
+
+        SNAPSHOTOPAQUE(surface, PSURFACE, REALPOS, PWINDOW->m_sAdditionalConfigData.rounding == -1 ? *PROUNDING : PWINDOW->m_sAdditionalConfigData.rounding);
+    };
+
+    // front to back, the reverse of renderAllClientsForMonitor. Without occlusion only the windows matter, for the blur.
+    if (prep.occlude) {
+        for (auto it = pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY].rbegin(); it != pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY].rend(); ++it)
+            SNAPSHOTLAYER(*it);
+        for (auto it = pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_TOP].rbegin(); it != pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_TOP].rend(); ++it)
+            SNAPSHOTLAYER(*it);
+    }
+
+    for (auto it = m_mRenderLists[pMonitor].items.rbegin(); it != m_mRenderLists[pMonitor].items.rend(); ++it)
+        SNAPSHOTWINDOW(*it);
 
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (w.m_iWorkspaceID != pWorkspace->m_iID || !w.m_bIsFullscreen)
+    if (prep.occlude) {
+        // the static blur cache is made from the whole background, nothing above may cut into it
+        if (g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].blurFBShouldRender)
+            prep.firstBelowBlurCache = prep.surfaces.size();
+
+        for (auto it = pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM].rbegin(); it != pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM].rend(); ++it)
+            SNAPSHOTLAYER(*it);
+        for (auto it = pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND].rbegin(); it != pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND].rend(); ++it)
+            SNAPSHOTLAYER(*it);
+
+        // and the clear, keyed on the monitor
+        prep.addSurface(pMonitor).box = {0, 0, prep.width, prep.height};
+    }
+
+    // nothing from here on looks at anything but the snapshot
+    dispatchPerSurface(m_pFramePrepPool.get(), prep, prepareOpaque);
+}
+
+void CHyprRenderer::finishFramePrep(SMonitor* pMonitor, pixman_region32_t* pDamage) {
+    auto& prep = m_mFramePreps[pMonitor];
+
+    m_pFramePrepPool->wait();
+
+    // the running union is one chain, the rest is per surface again
+    accumulateOpaque(prep);
+    dispatchPerSurface(m_pFramePrepPool.get(), prep, clipDamage);
+    m_pFramePrepPool->wait();
+
+    pixman_region32_copy(pDamage, &prep.damage);
+
+    g_pHyprOpenGL->m_sFrameStats.framePrepWorkUs = prep.workNs / 1000.f;
+    g_pHyprOpenGL->m_sFrameStats.framePrepThreads = m_pFramePrepPool->threads();
+
+    if (!prep.occlude)
+        return;
+
+    for (auto& s : prep.surfaces) {
+        // handed over as is, the prep gets a fresh one for reset() to free
+        m_mOccludedDamage[s.pOwner] = s.visible;
+        pixman_region32_init(&s.visible);
+
+        g_pHyprOpenGL->m_sFrameStats.pixelsOccluded += s.pixelsOccluded;
+        g_pHyprOpenGL->m_sFrameStats.surfacesCulled += s.culled;
+    }
+}
+
+pixman_region32_t* CHyprRenderer::getOccludedDamage(void* pOwner) {
+    const auto IT = m_mOccludedDamage.find(pOwner);
+
+    return IT == m_mOccludedDamage.end() ? nullptr : &IT->second;
+}
+
+void CHyprRenderer::clearOcclusion() {
+    for (auto& [owner, region] : m_mOccludedDamage)
+        pixman_region32_fini(&region);
+
+    m_mOccludedDamage.clear();
+}
+
+void CHyprRenderer::prepareRenderList(SMonitor* pMonitor) {
+    auto& renderList = m_mRenderLists[pMonitor];
+
+    renderList.rebuilt = renderList.dirty;
+
+    if (renderList.dirty) {
+        const auto BUILDSTART = std::chrono::high_resolution_clock::now();
+
+        renderList.candidates.clear();
+
+        for (auto& w : g_pCompositor->m_lWindows) {
+            if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
+                continue;
+
+            if (!shouldRenderWorkspaceOf(&w, pMonitor))
+                continue;
+
+            SRenderListItem item;
+            item.pWindow = &w;
+            item.pass = w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID ? RENDERPASS_SPECIAL : w.m_bIsFloating ? RENDERPASS_FLOATING : RENDERPASS_TILED;
+            renderList.candidates.push_back(item);
+        }
+
+        // one walk over the windows, stable so every pass keeps the stacking order
+        std::stable_sort(renderList.candidates.begin(), renderList.candidates.end(), [](const SRenderListItem& a, const SRenderListItem& b) { return a.pass < b.pass; });
+
+        renderList.dirty = false;
+        renderList.buildTimeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BUILDSTART).count() / 1000.f;
+    }
+
+    // windows move without the list changing (animations, a client resizing itself), so whether they're on
+    // the monitor at all is up to the frame
+    const wlr_box MONITORBOX = monitorLayoutBox(*pMonitor);
+
+    renderList.items.clear();
+
+    for (auto& candidate : renderList.candidates) {
+        wlr_box geometry = candidate.pWindow->getFullWindowBoundingBox();
+        wlr_box intersection;
+
+        if (!wlr_box_intersection(&intersection, &geometry, &MONITORBOX))
             continue;
 
-        // found it!
-        renderWindow(&w, pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL);
+        const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(candidate.pWindow->m_iWorkspaceID);
+        const auto RENDEROFFSET = PWORKSPACE ? PWORKSPACE->m_vRenderOffset.vec() : Vector2D();
 
-        pWorkspaceWindow = &w;
+        auto& item = renderList.items.emplace_back(candidate);
+        item.realPosition = item.pWindow->m_vRealPosition.vec() + RENDEROFFSET;
+        item.fullBox = geometry;
+        item.fullBox.x += RENDEROFFSET.x;
+        item.fullBox.y += RENDEROFFSET.y;
     }
+}
 
-    // then render windows over fullscreen
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (w.m_iWorkspaceID != pWorkspaceWindow->m_iWorkspaceID || !w.m_bCreatedOverFullscreen || !w.m_bIsMapped)
+void CHyprRenderer::invalidateRenderLists() {
+    for (auto& [monitor, renderList] : m_mRenderLists)
+        renderList.dirty = true;
+}
+
+static void countSurface(wlr_surface* surface, int x, int y, void* data) {
+    (*(int*)data)++;
+}
+
+SScanoutInputs CHyprRenderer::gatherScanoutInputs(SMonitor* pMonitor, CWindow** pWindowOut) {
+    static auto *const PDEBUGOVERLAY = &g_pConfigManager->getConfigValuePtr("debug:overlay")->intValue;
+
+    SScanoutInputs inputs;
+
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace);
+
+    // the common case, nothing else matters then
+    inputs.fullscreenWorkspace = PWORKSPACE && PWORKSPACE->m_bHasFullscreenWindow && PWORKSPACE->m_efFullscreenMode == FULLSCREEN_FULL;
+    if (!inputs.fullscreenWorkspace)
+        return inputs;
+
+    inputs.specialWorkspaceOpen = pMonitor->specialWorkspaceOpen;
+
+    // the fullscreen path only draws the workspace's own windows, see renderWorkspaceWithFullscreenWindow
+    CWindow* pFullscreenWindow = nullptr;
+    for (auto& item : m_mRenderLists[pMonitor].items) {
+        const auto PWINDOW = item.pWindow;
+
+        if (PWINDOW->m_iWorkspaceID != PWORKSPACE->m_iID || PWINDOW->m_bHidden)
             continue;
 
-        renderWindow(&w, pMonitor, time, true);
+        if (PWINDOW->m_bFadingOut)
+            inputs.windowsFadingOut = true;
+
+        if (PWINDOW->m_bIsFullscreen)
+            pFullscreenWindow = PWINDOW;
+        else if (PWINDOW->m_bCreatedOverFullscreen && PWINDOW->m_bIsMapped)
+            inputs.windowsAbove = true;
     }
 
-    // and then special windows
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
+    inputs.fullscreenWindowFound = pFullscreenWindow;
+    if (!pFullscreenWindow)
+        return inputs;
+
+    inputs.animating = PWORKSPACE->m_vRenderOffset.isBeingAnimated() || PWORKSPACE->m_fAlpha.isBeingAnimated() || pFullscreenWindow->m_vRealPosition.isBeingAnimated() ||
+        pFullscreenWindow->m_vRealSize.isBeingAnimated() || pFullscreenWindow->m_fAlpha.isBeingAnimated();
+
+    for (auto& ls : pMonitor->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY]) {
+        if (ls->fadingOut || ls->layerSurface->mapped)
+            inputs.overlayLayers = true;
+    }
+
+    inputs.dragIcon = g_pInputManager->m_sDrag.dragIcon && g_pInputManager->m_sDrag.iconMapped;
+    inputs.debugOverlays = pMonitor->ID == 0 && (*PDEBUGOVERLAY == 1 || g_pHyprError->active());
+
+    inputs.softwareCursor = pMonitor->output->software_cursor_locks > 0;
+
+    wlr_output_cursor* cursor;
+    wl_list_for_each(cursor, &pMonitor->output->cursors, link) {
+        if (cursor->enabled && cursor->visible && pMonitor->output->hardware_cursor != cursor)
+            inputs.softwareCursor = true;
+    }
+
+    // not about blur, but it checks everything that makes a window show what's behind it
+    inputs.opaque = !windowNeedsBlur(pFullscreenWindow);
+
+    inputs.windowPosition = pFullscreenWindow->m_vRealPosition.vec();
+    inputs.windowSize = pFullscreenWindow->m_vRealSize.vec();
+    inputs.monitorPosition = pMonitor->vecPosition;
+    inputs.monitorSize = pMonitor->vecSize;
+    inputs.outputWidth = pMonitor->output->width;
+    inputs.outputHeight = pMonitor->output->height;
+    inputs.outputTransform = pMonitor->output->transform;
+
+    const auto PSURFACE = g_pXWaylandManager->getWindowSurface(pFullscreenWindow);
+
+    inputs.hasBuffer = PSURFACE && PSURFACE->buffer;
+    if (!inputs.hasBuffer)
+        return inputs;
+
+    wlr_surface_for_each_surface(PSURFACE, countSurface, &inputs.surfaces);
+
+    if (!pFullscreenWindow->m_bIsX11)
+        inputs.surfaces += wl_list_length(&pFullscreenWindow->m_uSurface.xdg->popups);
+
+    inputs.bufferWidth = PSURFACE->current.buffer_width;
+    inputs.bufferHeight = PSURFACE->current.buffer_height;
+    inputs.bufferTransform = PSURFACE->current.transform;
+    inputs.bufferCropped = PSURFACE->current.viewport.has_src;
+
+    *pWindowOut = pFullscreenWindow;
+
+    return inputs;
+}
+
+bool CHyprRenderer::attemptDirectScanout(SMonitor* pMonitor, timespec* time) {
+    const bool WASSCANNEDOUT = pMonitor->scanoutFallback == SCANOUT_OK;
+
+    CWindow* pWindow = nullptr;
+    pMonitor->scanoutFallback = getScanoutFallback(gatherScanoutInputs(pMonitor, &pWindow));
+
+    if (pMonitor->scanoutFallback == SCANOUT_OK) {
+        // nothing new since the last one, keep showing it
+        if (WASSCANNEDOUT && !pixman_region32_not_empty(&pMonitor->damage->current))
+            return true;
+
+        const auto PSURFACE = g_pXWaylandManager->getWindowSurface(pWindow);
+
+        wlr_output_attach_buffer(pMonitor->output, &PSURFACE->buffer->base);
+
+        if (wlr_output_test(pMonitor->output)) {
+            wlr_surface_send_frame_done(PSURFACE, time);
+            wlr_presentation_surface_sampled_on_output(g_pCompositor->m_sWLRPresentation, PSURFACE, pMonitor->output);
+
+            pMonitor->awaitingPresentation = wlr_output_commit(pMonitor->output);
+
+            if (pMonitor->awaitingPresentation) {
+                if (!WASSCANNEDOUT)
+                    Debug::log(LOG, "Direct scanout on %s started", pMonitor->szName.c_str());
+
+                return true;
+            }
+        } else {
+            wlr_output_rollback(pMonitor->output);
+        }
+
+        pMonitor->scanoutFallback = SCANOUT_REJECTED;
+    }
+
+    // primaryFB missed everything that happened while scanning out
+    if (WASSCANNEDOUT) {
+        Debug::log(LOG, "Direct scanout on %s stopped: %s", pMonitor->szName.c_str(), scanoutFallbackToString(pMonitor->scanoutFallback).c_str());
+        damageMonitor(pMonitor);
+    }
+
+    return false;
+}
+
+std::string CHyprRenderer::scanoutFallbackToString(eScanoutFallback fallback) {
+    switch (fallback) {
+        case SCANOUT_OK: return "none";
+        case SCANOUT_NO_FULLSCREEN: return "no fullscreen window";
+        case SCANOUT_SPECIAL_WORKSPACE: return "special workspace open";
+        case SCANOUT_WINDOWS_ABOVE: return "windows above fullscreen";
+        case SCANOUT_OVERLAYS: return "overlays";
+        case SCANOUT_SOFTWARE_CURSOR: return "software cursor";
+        case SCANOUT_ANIMATING: return "animating";
+        case SCANOUT_NOT_OPAQUE: return "not opaque";
+        case SCANOUT_SUBSURFACES: return "subsurfaces or popups";
+        case SCANOUT_GEOMETRY: return "buffer doesn't match the output";
+        case SCANOUT_NO_BUFFER: return "no buffer";
+        case SCANOUT_REJECTED: return "rejected by the backend";
+    }
+
+    return "unknown";
+}
+
+void CHyprRenderer::renderWorkspaceWithFullscreenWindow(SMonitor* pMonitor, CWorkspace* pWorkspace, timespec* time) {
+    const auto& RENDERITEMS = m_mRenderLists[pMonitor].items;
+
+    for (auto& item : RENDERITEMS) {
+        if (item.pWindow->m_iWorkspaceID != pWorkspace->m_iID || !item.pWindow->m_bIsFullscreen)
             continue;
 
-        if (w.m_iWorkspaceID != SPECIAL_WORKSPACE_ID)
+        // found it!
+        renderWindow(item.pWindow, pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL);
+    }
+
+    // then render windows over fullscreen
+    for (auto& item : RENDERITEMS) {
+        if (item.pWindow->m_iWorkspaceID != pWorkspace->m_iID || !item.pWindow->m_bCreatedOverFullscreen || !item.pWindow->m_bIsMapped)
             continue;
 
-        if (!shouldRenderWindow(&w, pMonitor))
+        renderWindow(item.pWindow, pMonitor, time, true);
+    }
+
+    // and then special windows
+    for (auto& item : RENDERITEMS) {
+        if (item.pass != RENDERPASS_SPECIAL)
             continue;
 
         // render the bad boy
-        renderWindow(&w, pMonitor, time, true);
+        renderWindow(item.pWindow, pMonitor, time, true);
     }
 
     // and the overlay layers
@@ -134,12 +594,27 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec*
     if (pWindow->m_bHidden)
         return;
 
+    // only draw what isn't covered by opaque surfaces above
+    const auto PVISIBLEDAMAGE = getOccludedDamage(pWindow);
+    if (PVISIBLEDAMAGE && !pixman_region32_not_empty(PVISIBLEDAMAGE)) {
+        // fully covered, the client still gets its frame
+        if (!pWindow->m_bFadingOut)
+            wlr_surface_for_each_surface(g_pXWaylandManager->getWindowSurface(pWindow), sendFrameDone, time);
+        return;
+    }
+
+    const auto PFRAMEDAMAGE = g_pHyprOpenGL->m_RenderData.pDamage;
+    if (PVISIBLEDAMAGE)
+        g_pHyprOpenGL->m_RenderData.pDamage = PVISIBLEDAMAGE;
+
     if (pWindow->m_bFadingOut) {
         if (pMonitor->ID == pWindow->m_iMonitorID) // TODO: fix this
             g_pHyprOpenGL->renderSnapshot(&pWindow);
+        g_pHyprOpenGL->m_RenderData.pDamage = PFRAMEDAMAGE;
         return;
     }
-    
+
+
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
     const auto REALPOS = pWindow->m_vRealPosition.vec() + PWORKSPACE->m_vRenderOffset.vec();
     SRenderData renderdata = {pMonitor->output, time, REALPOS.x, REALPOS.y};
@@ -148,16 +623,10 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec*
     renderdata.h = std::clamp(pWindow->m_vRealSize.vec().y, (double)5, (double)1337420); // otherwise we'll have issues later with invalid boxes
     renderdata.dontRound = pWindow->m_bIsFullscreen && PWORKSPACE->m_efFullscreenMode == FULLSCREEN_FULL;
     renderdata.fadeAlpha = pWindow->m_fAlpha.fl() * (PWORKSPACE->m_fAlpha.fl() / 255.f);
-    renderdata.alpha = pWindow->m_bIsFullscreen ? g_pConfigManager->getFloat("decoration:fullscreen_opacity") : pWindow == g_pCompositor->m_pLastWindow ? g_pConfigManager->getFloat("decoration:active_opacity") : g_pConfigManager->getFloat("decoration:inactive_opacity");
+    renderdata.alpha = getWindowOpacity(pWindow);
     renderdata.decorate = decorate && !pWindow->m_bX11DoesntWantBorders;
     renderdata.rounding = pWindow->m_sAdditionalConfigData.rounding;
 
-    // apply window special data
-    if (pWindow->m_sSpecialRenderData.alphaInactive == -1)
-        renderdata.alpha *= pWindow->m_sSpecialRenderData.alpha;
-    else
-        renderdata.alpha *= pWindow == g_pCompositor->m_pLastWindow ? pWindow->m_sSpecialRenderData.alpha : pWindow->m_sSpecialRenderData.alphaInactive;
-
     g_pHyprOpenGL->m_pCurrentWindow = pWindow;
 
     // render window decorations first
@@ -178,17 +647,36 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec*
     }
 
     g_pHyprOpenGL->m_pCurrentWindow = nullptr;
+    g_pHyprOpenGL->m_RenderData.pDamage = PFRAMEDAMAGE;
 }
 
 void CHyprRenderer::renderLayer(SLayerSurface* pLayer, SMonitor* pMonitor, timespec* time) {
+    const auto PVISIBLEDAMAGE = getOccludedDamage(pLayer);
+    if (PVISIBLEDAMAGE && !pixman_region32_not_empty(PVISIBLEDAMAGE)) {
+        if (!pLayer->fadingOut)
+            wlr_surface_for_each_surface(pLayer->layerSurface->surface, sendFrameDone, time);
+        return;
+    }
+
+    const auto PFRAMEDAMAGE = g_pHyprOpenGL->m_RenderData.pDamage;
+    if (PVISIBLEDAMAGE)
+        g_pHyprOpenGL->m_RenderData.pDamage = PVISIBLEDAMAGE;
+
     if (pLayer->fadingOut) {
         g_pHyprOpenGL->renderSnapshot(&pLayer);
+        g_pHyprOpenGL->m_RenderData.pDamage = PFRAMEDAMAGE;
         return;
     }
 
+    // a static layer changing opacity changes the cached blur too
+    if ((pLayer->layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || pLayer->layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM) && pLayer->alpha.isBeingAnimated())
+        g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor);
+
     SRenderData renderdata = {pMonitor->output, time, pLayer->geometry.x, pLayer->geometry.y};
     renderdata.fadeAlpha = pLayer->alpha.fl();
     wlr_surface_for_each_surface(pLayer->layerSurface->surface, renderSurface, &renderdata);
+
+    g_pHyprOpenGL->m_RenderData.pDamage = PFRAMEDAMAGE;
 }
 
 void CHyprRenderer::renderAllClientsForMonitor(const int& ID, timespec* time) {
@@ -197,6 +685,17 @@ void CHyprRenderer::renderAllClientsForMonitor(const int& ID, timespec* time) {
     if (!PMONITOR)
         return;
 
+    const auto& RENDERLIST = m_mRenderLists[PMONITOR];
+    g_pHyprOpenGL->m_sFrameStats.renderListItems = RENDERLIST.items.size();
+    g_pHyprOpenGL->m_sFrameStats.renderListRebuilt = RENDERLIST.rebuilt;
+    g_pHyprOpenGL->m_sFrameStats.renderListBuildTimeUs = RENDERLIST.buildTimeUs;
+
+    // since this monitor's last frame
+    auto& rectCounts = m_mDamageRectCounts[PMONITOR];
+    g_pHyprOpenGL->m_sFrameStats.damageRectsRaw = rectCounts.raw;
+    g_pHyprOpenGL->m_sFrameStats.damageRectsMerged = rectCounts.merged;
+    rectCounts = SDamageRectCounts();
+
     // Render layer surfaces below windows for monitor
     for (auto& ls : PMONITOR->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]) {
         renderLayer(ls, PMONITOR, time);
@@ -205,6 +704,9 @@ void CHyprRenderer::renderAllClientsForMonitor(const int& ID, timespec* time) {
         renderLayer(ls, PMONITOR, time);
     }
 
+    // the static part is drawn, blur it for the cache if it's due
+    g_pHyprOpenGL->preBlurForCurrentMonitor();
+
     // if there is a fullscreen window, render it and then do not render anymore.
     // fullscreen window will hide other windows and top layers
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(PMONITOR->activeWorkspace);
@@ -214,55 +716,10 @@ void CHyprRenderer::renderAllClientsForMonitor(const int& ID, timespec* time) {
         return;
     }
 
-    // Non-floating
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
-            continue;
-
-        if (w.m_bIsFloating)
-            continue;  // floating are in the second pass
-
-        if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
-            continue; // special are in the third pass
-
-        if (!shouldRenderWindow(&w, PMONITOR))
-            continue;
-
-        // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
-    }
-
-    // floating on top
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
-            continue;
-
-        if (!w.m_bIsFloating)
-            continue;
-
-        if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
-            continue;
-
-        if (!shouldRenderWindow(&w, PMONITOR))
-            continue;
-
+    // tiled, then floating on top, then special
+    for (auto& item : m_mRenderLists[PMONITOR].items) {
         // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
-    }
-
-    // and then special
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
-            continue;
-            
-        if (w.m_iWorkspaceID != SPECIAL_WORKSPACE_ID)
-            continue;
-
-        if (!shouldRenderWindow(&w, PMONITOR))
-            continue;
-
-        // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
+        renderWindow(item.pWindow, PMONITOR, time, true);
     }
 
     // Render surfaces above windows for monitor
@@ -524,21 +981,17 @@ void CHyprRenderer::damageSurface(wlr_surface* pSurface, double x, double y) {
 
     pixman_region32_translate(&damageBox, x, y);
 
-    for (auto& m : g_pCompositor->m_lMonitors) {
-        double lx = 0, ly = 0;
-        wlr_output_layout_output_coords(g_pCompositor->m_sWLROutputLayout, m.output, &lx, &ly);
-        pixman_region32_translate(&damageBox, lx, ly);
-        wlr_region_scale(&damageBox, &damageBox, m.scale);
-        wlr_output_damage_add(m.damage, &damageBox);
-        pixman_region32_translate(&damageBox, -lx, -ly);
+    PIXMAN_DAMAGE_FOREACH(&damageBox) {
+        const auto RECT = RECTSARR[i];
+        addPendingDamage({RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1});
     }
 
-    pixman_region32_fini(&damageBox);
-
     static auto *const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
 
     if (*PLOGDAMAGE)
         Debug::log(LOG, "Damage: Surface (extents): xy: %d, %d wh: %d, %d", damageBox.extents.x1, damageBox.extents.y1, damageBox.extents.x2 - damageBox.extents.x1, damageBox.extents.y2 - damageBox.extents.y1);
+
+    pixman_region32_fini(&damageBox);
 }
 
 void CHyprRenderer::damageWindow(CWindow* pWindow) {
@@ -547,13 +1000,7 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
         // TODO TEMP: revise when added shadows/etc
 
         wlr_box damageBox = {pWindow->m_vRealPosition.vec().x, pWindow->m_vRealPosition.vec().y, pWindow->m_vRealSize.vec().x, pWindow->m_vRealSize.vec().y};
-        for (auto& m : g_pCompositor->m_lMonitors) {
-            wlr_box fixedDamageBox = damageBox;
-            fixedDamageBox.x -= m.vecPosition.x;
-            fixedDamageBox.y -= m.vecPosition.y;
-            scaleBox(&fixedDamageBox, m.scale);
-            wlr_output_damage_add_box(m.damage, &fixedDamageBox);
-        }
+        addPendingDamage(damageBox);
 
         static auto *const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
 
@@ -563,13 +1010,7 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
         // damage by real size & pos + border size * 2 (JIC)
         static auto *const PBORDERSIZE = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
         wlr_box damageBox = { pWindow->m_vRealPosition.vec().x - *PBORDERSIZE - 1, pWindow->m_vRealPosition.vec().y - *PBORDERSIZE - 1, pWindow->m_vRealSize.vec().x + 2 * *PBORDERSIZE + 2, pWindow->m_vRealSize.vec().y + 2 * *PBORDERSIZE + 2};
-        for (auto& m : g_pCompositor->m_lMonitors) {
-            wlr_box fixedDamageBox = damageBox;
-            fixedDamageBox.x -= m.vecPosition.x;
-            fixedDamageBox.y -= m.vecPosition.y;
-            scaleBox(&fixedDamageBox, m.scale);
-            wlr_output_damage_add_box(m.damage, &fixedDamageBox);
-        }
+        addPendingDamage(damageBox);
 
         static auto *const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
 
@@ -579,9 +1020,12 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
 }
 
 void CHyprRenderer::damageMonitor(SMonitor* pMonitor) {
+    // all of it anyways, nothing to merge
     wlr_box damageBox = {0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y};
     wlr_output_damage_add_box(pMonitor->damage, &damageBox);
 
+    m_mDamageRectCounts[pMonitor].raw++;
+
     static auto *const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
 
     if (*PLOGDAMAGE)
@@ -589,11 +1033,7 @@ void CHyprRenderer::damageMonitor(SMonitor* pMonitor) {
 }
 
 void CHyprRenderer::damageBox(wlr_box* pBox) {
-    for (auto& m : g_pCompositor->m_lMonitors) {
-        wlr_box damageBox = {pBox->x - m.vecPosition.x, pBox->y - m.vecPosition.y, pBox->width, pBox->height};
-        scaleBox(&damageBox, m.scale);
-        wlr_output_damage_add_box(m.damage, &damageBox);
-    }
+    addPendingDamage(*pBox);
 
     static auto *const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
 
@@ -606,6 +1046,74 @@ void CHyprRenderer::damageBox(const int& x, const int& y, const int& w, const in
     damageBox(&box);
 }
 
+void CHyprRenderer::addPendingDamage(const wlr_box& box) {
+    if (box.width <= 0 || box.height <= 0)
+        return;
+
+    m_vPendingDamage.push_back(box);
+
+    // adding to the output damage used to schedule the frame, flushDamage() only runs inside one
+    for (auto& m : g_pCompositor->m_lMonitors) {
+        const wlr_box MONITORBOX = monitorLayoutBox(m);
+        wlr_box intersection;
+
+        if (m.output && wlr_box_intersection(&intersection, &box, &MONITORBOX))
+            wlr_output_schedule_frame(m.output);
+    }
+
+    // no monitor is taking frames (e.g. all of them are off), don't grow forever
+    if (m_vPendingDamage.size() > MAX_PENDING_DAMAGE)
+        flushDamage();
+}
+
+void CHyprRenderer::flushDamage() {
+    if (m_vPendingDamage.empty())
+        return;
+
+    for (auto& m : g_pCompositor->m_lMonitors) {
+        if (!m.damage)
+            continue; // not set up (yet), or headless
+
+        const wlr_box MONITORBOX = monitorLayoutBox(m);
+        auto& rectCounts = m_mDamageRectCounts[&m];
+
+        pixman_region32_t damageRegion;
+        pixman_region32_init(&damageRegion);
+
+        for (auto& box : m_vPendingDamage) {
+            wlr_box intersection;
+            if (!wlr_box_intersection(&intersection, &box, &MONITORBOX))
+                continue;
+
+            rectCounts.raw++;
+            pixman_region32_union_rect(&damageRegion, &damageRegion, intersection.x, intersection.y, intersection.width, intersection.height);
+        }
+
+        if (!pixman_region32_not_empty(&damageRegion)) {
+            pixman_region32_fini(&damageRegion);
+            continue;
+        }
+
+        pixman_region32_translate(&damageRegion, -MONITORBOX.x, -MONITORBOX.y);
+        wlr_region_scale(&damageRegion, &damageRegion, m.scale);
+
+        // every rect is a scissored draw per quad later, past a point one big one is cheaper
+        if (pixman_region32_n_rects(&damageRegion) > MAX_DAMAGE_RECTS) {
+            const auto EXTENTS = *pixman_region32_extents(&damageRegion);
+            pixman_region32_fini(&damageRegion);
+            pixman_region32_init_rect(&damageRegion, EXTENTS.x1, EXTENTS.y1, EXTENTS.x2 - EXTENTS.x1, EXTENTS.y2 - EXTENTS.y1);
+        }
+
+        rectCounts.merged += pixman_region32_n_rects(&damageRegion);
+
+        wlr_output_damage_add(m.damage, &damageRegion);
+
+        pixman_region32_fini(&damageRegion);
+    }
+
+    m_vPendingDamage.clear();
+}
+
 void CHyprRenderer::renderDragIcon(SMonitor* pMonitor, timespec* time) {
     if (!(g_pInputManager->m_sDrag.dragIcon && g_pInputManager->m_sDrag.iconMapped && g_pInputManager->m_sDrag.dragIcon->surface))
         return;
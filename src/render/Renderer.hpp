@@ -6,6 +6,8 @@
 #include "../helpers/Workspace.hpp"
 #include "../Window.hpp"
 #include "OpenGL.hpp"
+#include "FramePrep.hpp"
+#include "../helpers/WorkerPool.hpp"
 
 struct SMonitorRule;
 
@@ -17,8 +19,45 @@ enum DAMAGETRACKINGMODES {
     DAMAGE_TRACKING_FULL
 };
 
+enum eRenderPass {
+    RENDERPASS_TILED = 0,
+    RENDERPASS_FLOATING,
+    RENDERPASS_SPECIAL
+};
+
+// a window drawn on a monitor, see CHyprRenderer::prepareRenderList
+struct SRenderListItem {
+    CWindow*    pWindow = nullptr;
+    eRenderPass pass = RENDERPASS_TILED;
+
+    // refreshed every frame, layout coords with the workspace render offset applied
+    Vector2D    realPosition;
+    wlr_box     fullBox = {0, 0, 0, 0}; // decorations included
+};
+
+struct SMonitorRenderList {
+    std::vector<SRenderListItem> candidates; // on a workspace the monitor shows, in draw order: tiled, floating, special
+    std::vector<SRenderListItem> items;      // the candidates overlapping the monitor this frame
+
+    bool  dirty = true;
+    bool  rebuilt = false; // on this frame
+    float buildTimeUs = 0; // of the last rebuild
+};
+
+// damage handed to a monitor since its last frame, see CHyprRenderer::flushDamage
+struct SDamageRectCounts {
+    int raw = 0;    // boxes that hit the monitor
+    int merged = 0; // rects left after merging them
+};
+
+// past this many pending boxes flushDamage doesn't wait for a frame
+#define MAX_PENDING_DAMAGE 4096
+// past this many rects per flush a monitor gets their extents instead
+#define MAX_DAMAGE_RECTS 32
+
 class CHyprRenderer {
 public:
+    CHyprRenderer();
 
     void                renderAllClientsForMonitor(const int&, timespec*);
     void                outputMgrApplyTest(wlr_output_configuration_v1*, bool);
@@ -28,9 +67,24 @@ public:
     void                damageBox(wlr_box*);
     void                damageBox(const int& x, const int& y, const int& w, const int& h);
     void                damageMonitor(SMonitor*);
+    void                flushDamage();
     void                applyMonitorRule(SMonitor*, SMonitorRule*, bool force = false);
     bool                shouldRenderWindow(CWindow*, SMonitor*);
     bool                shouldRenderWindow(CWindow*);
+    // shouldRenderWindow without the geometry, what the render lists are built from
+    bool                shouldRenderWorkspaceOf(CWindow*, SMonitor*);
+    // snapshots the frame (render list, layers, opaque regions) and starts its region math on the worker pool.
+    // expandForBlur is for the blur around windows, only worth it with full damage tracking.
+    void                beginFramePrep(SMonitor*, pixman_region32_t* damage, bool expandForBlur);
+    // waits for the region math, damage is final after this and getOccludedDamage has what's left per surface
+    void                finishFramePrep(SMonitor*, pixman_region32_t* damage);
+    pixman_region32_t*  getOccludedDamage(void*);
+    void                clearOcclusion();
+    void                prepareRenderList(SMonitor*);
+    void                invalidateRenderLists();
+    SScanoutInputs      gatherScanoutInputs(SMonitor*, CWindow**);
+    bool                attemptDirectScanout(SMonitor*, timespec*);
+    std::string         scanoutFallbackToString(eScanoutFallback);
 
     DAMAGETRACKINGMODES damageTrackingModeFromStr(const std::string&);
 
@@ -40,7 +94,25 @@ private:
     void                renderWindow(CWindow*, SMonitor*, timespec*, bool);
     void                renderLayer(SLayerSurface*, SMonitor*, timespec*);
     void                renderDragIcon(SMonitor*, timespec*);
+    bool                windowNeedsBlur(CWindow*);
+    // fullscreen / active / inactive opacity times the window rule's, what renderWindow draws with (fades not included)
+    float               getWindowOpacity(CWindow*);
+
+    void                addPendingDamage(const wlr_box&);
+
+    // layout coords, everything damaged since the last flushDamage
+    std::vector<wlr_box> m_vPendingDamage;
+    std::unordered_map<SMonitor*, SDamageRectCounts> m_mDamageRectCounts;
+
+    // what's left of the frame damage for a layer, window or monitor (its clear) once everything opaque above is cut out.
+    // Filled by finishFramePrep for the frame being rendered, empty means fully covered.
+    std::unordered_map<void*, pixman_region32_t> m_mOccludedDamage;
+
+    // windows to draw per monitor. Only rebuilt when something changed the scene, a client committing a new buffer doesn't.
+    std::unordered_map<SMonitor*, SMonitorRenderList> m_mRenderLists;
 
+    std::unordered_map<SMonitor*, SFramePrep> m_mFramePreps;
+    std::unique_ptr<CWorkerPool>              m_pFramePrepPool;
 
     friend class CHyprOpenGLImpl;
 };
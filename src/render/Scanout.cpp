@@ -0,0 +1,45 @@
+#include "Scanout.hpp"
+
+eScanoutFallback getScanoutFallback(const SScanoutInputs& in) {
+    if (!in.fullscreenWorkspace)
+        return SCANOUT_NO_FULLSCREEN;
+
+    if (in.specialWorkspaceOpen)
+        return SCANOUT_SPECIAL_WORKSPACE;
+
+    if (in.windowsFadingOut)
+        return SCANOUT_ANIMATING;
+
+    if (in.windowsAbove)
+        return SCANOUT_WINDOWS_ABOVE;
+
+    if (!in.fullscreenWindowFound)
+        return SCANOUT_NO_FULLSCREEN;
+
+    if (in.animating)
+        return SCANOUT_ANIMATING;
+
+    // anything else drawn on top
+    if (in.overlayLayers || in.dragIcon || in.debugOverlays)
+        return SCANOUT_OVERLAYS;
+
+    // a software cursor has to be drawn into the frame
+    if (in.softwareCursor)
+        return SCANOUT_SOFTWARE_CURSOR;
+
+    if (!in.opaque)
+        return SCANOUT_NOT_OPAQUE;
+
+    if (!in.hasBuffer)
+        return SCANOUT_NO_BUFFER;
+
+    if (in.surfaces != 1)
+        return SCANOUT_SUBSURFACES;
+
+    // the buffer has to be exactly what the output shows
+    if (in.windowPosition != in.monitorPosition || in.windowSize != in.monitorSize || in.bufferWidth != in.outputWidth || in.bufferHeight != in.outputHeight ||
+        in.bufferTransform != in.outputTransform || in.bufferCropped)
+        return SCANOUT_GEOMETRY;
+
+    return SCANOUT_OK;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../helpers/Vector2D.hpp"
+
+// why a frame didn't go straight from a client's buffer to the output, see getScanoutFallback
+enum eScanoutFallback {
+    SCANOUT_OK = 0,
+    SCANOUT_NO_FULLSCREEN,
+    SCANOUT_SPECIAL_WORKSPACE,
+    SCANOUT_WINDOWS_ABOVE,
+    SCANOUT_OVERLAYS,
+    SCANOUT_SOFTWARE_CURSOR,
+    SCANOUT_ANIMATING,
+    SCANOUT_NOT_OPAQUE,
+    SCANOUT_SUBSURFACES,
+    SCANOUT_GEOMETRY,
+    SCANOUT_NO_BUFFER,
+    SCANOUT_REJECTED
+};
+
+// everything the direct scanout decision looks at, filled by CHyprRenderer::gatherScanoutInputs
+struct SScanoutInputs {
+    // the active workspace
+    bool        fullscreenWorkspace     = false; // it has a FULLSCREEN_FULL window
+    bool        specialWorkspaceOpen    = false;
+    bool        fullscreenWindowFound   = false; // and it's in the render list
+    bool        windowsFadingOut        = false;
+    bool        windowsAbove            = false; // mapped, created over the fullscreen window
+    bool        animating               = false; // the workspace or the fullscreen window
+
+    // drawn on top
+    bool        overlayLayers           = false; // mapped or fading out
+    bool        dragIcon                = false;
+    bool        debugOverlays           = false; // debug overlay / error bar on this monitor
+    bool        softwareCursor          = false;
+
+    // the fullscreen window's surface
+    bool        opaque                  = false; // no opacity, fades or translucent regions
+    bool        hasBuffer               = false;
+    int         surfaces                = 0;     // in its surface tree, popups included
+    bool        bufferCropped           = false; // viewport with a source box
+    int         bufferWidth             = 0;
+    int         bufferHeight            = 0;
+    int         bufferTransform         = 0;
+    Vector2D    windowPosition;
+    Vector2D    windowSize;
+
+    // the output
+    Vector2D    monitorPosition;
+    Vector2D    monitorSize;
+    int         outputWidth             = 0;
+    int         outputHeight            = 0;
+    int         outputTransform         = 0;
+};
+
+// SCANOUT_OK if the fullscreen window's buffer can go to the output as is, else the first reason it can't.
+// Never returns SCANOUT_REJECTED, that's for the backend to say.
+eScanoutFallback getScanoutFallback(const SScanoutInputs&);
@@ -0,0 +1,130 @@
+#include "Shader.hpp"
+#include "OpenGL.hpp"
+
+#include <algorithm>
+
+void CShader::reflect(GLuint prog) {
+    program = prog;
+
+    m_mUniformLocations.clear();
+    m_mAttribLocations.clear();
+    m_mUniformValues.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+
+    glGetProgramiv(prog, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(prog, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(maxLength + 1, '\0');
+
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(prog, i, name.size(), &length, &size, &type, name.data());
+
+        const auto UNIFORMNAME = name.substr(0, length);
+        m_mUniformLocations[UNIFORMNAME] = glGetUniformLocation(prog, UNIFORMNAME.c_str());
+    }
+
+    glGetProgramiv(prog, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(prog, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+
+    name = std::string(maxLength + 1, '\0');
+
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(prog, i, name.size(), &length, &size, &type, name.data());
+
+        const auto ATTRIBNAME = name.substr(0, length);
+        m_mAttribLocations[ATTRIBNAME] = glGetAttribLocation(prog, ATTRIBNAME.c_str());
+    }
+
+    const auto ATTRIB = [&](const std::string& attrib) -> GLint {
+        const auto IT = m_mAttribLocations.find(attrib);
+        return IT == m_mAttribLocations.end() ? -1 : IT->second;
+    };
+
+    proj = getUniformLocation("proj");
+    tex = getUniformLocation("tex");
+    if (tex == -1)
+        tex = getUniformLocation("texture0"); // the external shader names its sampler differently
+    alpha = getUniformLocation("alpha");
+    color = getUniformLocation("color");
+    discardOpaque = getUniformLocation("discardOpaque");
+    topLeft = getUniformLocation("topLeft");
+    bottomRight = getUniformLocation("bottomRight");
+    fullSize = getUniformLocation("fullSize");
+    radius = getUniformLocation("radius");
+    primitiveMultisample = getUniformLocation("primitiveMultisample");
+    halfpixel = getUniformLocation("halfpixel");
+
+    posAttrib = ATTRIB("pos");
+    texAttrib = ATTRIB("texcoord");
+}
+
+GLint CShader::getUniformLocation(const std::string& uniform) {
+    const auto IT = m_mUniformLocations.find(uniform);
+    return IT == m_mUniformLocations.end() ? -1 : IT->second;
+}
+
+bool CShader::valueChanged(GLint location, const float* values, size_t count) {
+    const auto IT = m_mUniformValues.find(location);
+
+    if (IT != m_mUniformValues.end() && std::equal(values, values + count, IT->second.begin())) {
+        g_pHyprOpenGL->m_sFrameStats.uniformUploadsAvoided++;
+        return false;
+    }
+
+    auto& cached = m_mUniformValues[location];
+    std::copy(values, values + count, cached.begin());
+
+    g_pHyprOpenGL->m_sFrameStats.uniformUploads++;
+    return true;
+}
+
+void CShader::setUniform1i(GLint location, int value) {
+    const float VALUES[] = {(float)value};
+
+    if (location == -1 || !valueChanged(location, VALUES, 1))
+        return;
+
+    glUniform1i(location, value);
+}
+
+void CShader::setUniform1f(GLint location, float value) {
+    const float VALUES[] = {value};
+
+    if (location == -1 || !valueChanged(location, VALUES, 1))
+        return;
+
+    glUniform1f(location, value);
+}
+
+void CShader::setUniform2f(GLint location, float x, float y) {
+    const float VALUES[] = {x, y};
+
+    if (location == -1 || !valueChanged(location, VALUES, 2))
+        return;
+
+    glUniform2f(location, x, y);
+}
+
+void CShader::setUniform4f(GLint location, float x, float y, float z, float w) {
+    const float VALUES[] = {x, y, z, w};
+
+    if (location == -1 || !valueChanged(location, VALUES, 4))
+        return;
+
+    glUniform4f(location, x, y, z, w);
+}
+
+void CShader::setUniformMatrix3fv(GLint location, const float* matrix) {
+    if (location == -1 || !valueChanged(location, matrix, 9))
+        return;
+
+    glUniformMatrix3fv(location, 1, GL_FALSE, matrix);
+}
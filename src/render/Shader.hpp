@@ -1,22 +1,42 @@
 #pragma once
 
 #include "../defines.hpp"
-
-struct SQuad {
-    GLuint program;
-    GLint proj;
-    GLint color;
-    GLint posAttrib;
-    GLint texAttrib;
-};
+#include <array>
+#include <unordered_map>
 
 class CShader {
 public:
-    GLuint program;
-    GLint proj;
-    GLint tex;
-    GLint alpha;
-    GLint posAttrib;
-    GLint texAttrib;
-    GLint discardOpaque;
-};
\ No newline at end of file
+    GLuint program = 0;
+    GLint proj = -1;
+    GLint tex = -1;
+    GLint alpha = -1;
+    GLint color = -1;
+    GLint posAttrib = -1;
+    GLint texAttrib = -1;
+    GLint discardOpaque = -1;
+    GLint topLeft = -1;
+    GLint bottomRight = -1;
+    GLint fullSize = -1;
+    GLint radius = -1;
+    GLint primitiveMultisample = -1;
+    GLint halfpixel = -1;
+
+    // enumerates the active uniforms and attributes of a linked program once and fills the slots above
+    void  reflect(GLuint prog);
+    GLint getUniformLocation(const std::string&);
+
+    // these skip the upload if the program already holds the value.
+    // the program has to be in use.
+    void  setUniform1i(GLint location, int value);
+    void  setUniform1f(GLint location, float value);
+    void  setUniform2f(GLint location, float x, float y);
+    void  setUniform4f(GLint location, float x, float y, float z, float w);
+    void  setUniformMatrix3fv(GLint location, const float* matrix);
+
+private:
+    bool  valueChanged(GLint location, const float* values, size_t count);
+
+    std::unordered_map<std::string, GLint> m_mUniformLocations;
+    std::unordered_map<std::string, GLint> m_mAttribLocations;
+    std::unordered_map<GLint, std::array<float, 9>> m_mUniformValues;
+};
@@ -269,7 +269,7 @@ uniform float radius;
 uniform vec2 halfpixel;
 
 void main() {
-	vec2 uv = v_texcoord * 2.0;
+	vec2 uv = v_texcoord;
 
     vec4 sum = texture2D(tex, uv) * 4.0;
     sum += texture2D(tex, uv - halfpixel.xy * radius);
@@ -290,7 +290,7 @@ uniform float radius;
 uniform vec2 halfpixel;
 
 void main() {
-	vec2 uv = v_texcoord / 2.0;
+	vec2 uv = v_texcoord;
 
     vec4 sum = texture2D(tex, uv + vec2(-halfpixel.x * 2.0, 0.0) * radius);
     
@@ -23,7 +23,8 @@ void CHyprGroupBarDecoration::updateWindow(CWindow* pWindow) {
 
     if (pWindow->m_vRealPosition.vec() != m_vLastWindowPos || pWindow->m_vRealSize.vec() != m_vLastWindowSize) {
         // we draw 3px above the window's border with 3px
-        const auto BORDERSIZE = g_pConfigManager->getInt("general:border_size");
+        static auto *const PBORDERSIZE = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
+        const auto BORDERSIZE = *PBORDERSIZE;
 
         m_seExtents.topLeft = Vector2D(0, BORDERSIZE + 3 + 3);
         m_seExtents.bottomRight = Vector2D();
@@ -87,7 +88,10 @@ void CHyprGroupBarDecoration::draw(SMonitor* pMonitor) {
         if (rect.width <= 0 || rect.height <= 0)
             break;
 
-        CColor color = m_dwGroupMembers[i] == g_pCompositor->m_pLastWindow ? CColor(g_pConfigManager->getInt("dwindle:col.group_border_active")) : CColor(g_pConfigManager->getInt("dwindle:col.group_border"));
+        static auto *const PGROUPCOLACTIVE = &g_pConfigManager->getConfigValuePtr("dwindle:col.group_border_active")->intValue;
+        static auto *const PGROUPCOLINACTIVE = &g_pConfigManager->getConfigValuePtr("dwindle:col.group_border")->intValue;
+
+        CColor color = m_dwGroupMembers[i] == g_pCompositor->m_pLastWindow ? CColor(*PGROUPCOLACTIVE) : CColor(*PGROUPCOLINACTIVE);
         g_pHyprOpenGL->renderRect(&rect, color);
 
         xoff += PAD + BARW;
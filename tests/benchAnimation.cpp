@@ -0,0 +1,61 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+constexpr size_t WINDOWS = 1000;
+constexpr size_t ANIMATING = 10;
+constexpr size_t FRAMES = 30; // ~500ms at 60Hz, inside the default window animation
+
+int main() {
+    startHeadless();
+
+    const auto PMONITOR = addHeadlessMonitor(Vector2D(0, 0), Vector2D(1920, 1080));
+
+    std::vector<CWindow*> windows;
+    for (size_t i = 0; i < WINDOWS; ++i)
+        windows.push_back(addHeadlessWindow(PMONITOR, Vector2D((i * 37) % 1600, (i * 23) % 900), Vector2D(320, 180), i % 4 == 0));
+
+    // the animating ones are closing: unmapped windows popping out and fading. A mapped window would get configured
+    // every frame, which needs a client.
+    std::vector<CWindow*> closing(windows.begin(), windows.begin() + ANIMATING);
+    for (auto& w : closing)
+        w->m_bIsMapped = false;
+
+    std::chrono::steady_clock::time_point animationBegin;
+    const auto                            START = [&](size_t i) {
+        for (auto& w : closing) {
+            const auto FROM = w->m_vRealPosition.vec();
+            w->m_vRealPosition = FROM + (i % 2 ? Vector2D(-100, -100) : Vector2D(100, 100));
+            w->m_vRealSize = w->m_vRealSize.vec() + (i % 2 ? Vector2D(200, 200) : Vector2D(-200, -200));
+            w->m_fAlpha = i % 2 ? 255.f : 0.f;
+        }
+        animationBegin = std::chrono::steady_clock::now();
+    };
+
+    // no animations, the frame callback of an idle desktop
+    const auto IDLE = benchmarkNs(100000, [&](size_t i) { g_pAnimationManager->tick(PMONITOR, std::chrono::steady_clock::now()); });
+
+    // 10 of 1000 in flight, restarted before they end so every tick has work
+    const auto TICK = benchmarkNs(FRAMES * 1000, [&](size_t i) {
+        if (i % FRAMES == 0)
+            START(i / FRAMES);
+
+        g_pAnimationManager->tick(PMONITOR, animationBegin + std::chrono::milliseconds(16 * (i % FRAMES + 1)));
+        g_pHyprRenderer->flushDamage();
+    });
+
+    // what every frame used to pay: asking every var of every window whether it's in flight
+    const auto WALK = benchmarkNs(100000, [&](size_t i) {
+        size_t animating = 0;
+        for (auto& w : g_pCompositor->m_lWindows)
+            animating += w.m_vRealPosition.isBeingAnimated() + w.m_vRealSize.isBeingAnimated() + w.m_cRealBorderColor.isBeingAnimated() + w.m_fAlpha.isBeingAnimated();
+        doNotOptimize(animating);
+    });
+
+    printBenchmark("tick, 1000 windows, none animating", IDLE);
+    printBenchmark("tick + damage, 1000 windows, 10 animating", TICK);
+    printBenchmark("walk of all 4000 vars", WALK);
+
+    stopHeadless();
+
+    return 0;
+}
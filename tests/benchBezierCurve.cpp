@@ -0,0 +1,28 @@
+#include "shared.hpp"
+#include "../src/helpers/BezierCurve.hpp"
+
+#include <random>
+
+int main() {
+    std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
+
+    CBezierCurve curve;
+    curve.setup(&points);
+
+    constexpr size_t ITERATIONS = 10000000;
+
+    // an animation walks x forward a frame at a time
+    printBenchmark("getYForPoint, sequential x", benchmarkNs(ITERATIONS, [&](size_t i) { doNotOptimize(curve.getYForPoint((i % 1000) / 1000.f)); }));
+
+    // many variables at different stages, the lookups jump around
+    std::vector<float> xs(4096);
+    std::mt19937       rng(42);
+    for (auto& x : xs)
+        x = std::uniform_real_distribution<float>(0.f, 1.f)(rng);
+
+    printBenchmark("getYForPoint, random x", benchmarkNs(ITERATIONS, [&](size_t i) { doNotOptimize(curve.getYForPoint(xs[i % xs.size()])); }));
+
+    printBenchmark("setup", benchmarkNs(10000, [&](size_t i) { curve.setup(&points); }));
+
+    return 0;
+}
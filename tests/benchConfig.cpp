@@ -0,0 +1,22 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+int main() {
+    startHeadless();
+
+    // what every hot path did before caching: a string built and hashed per lookup
+    const auto GETINT = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(g_pConfigManager->getInt("general:border_size")); });
+    const auto GETSTRING = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(g_pConfigManager->getString("animations:curve").length()); });
+
+    // what they do now
+    static auto* const PBORDERSIZE = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
+    const auto         CACHED = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(*PBORDERSIZE); });
+
+    printBenchmark("getInt", GETINT);
+    printBenchmark("getString", GETSTRING);
+    printBenchmark("cached getConfigValuePtr", CACHED);
+
+    stopHeadless();
+
+    return 0;
+}
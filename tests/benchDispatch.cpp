@@ -0,0 +1,66 @@
+#include "shared.hpp"
+#include "headless.hpp"
+#include "../src/debug/HyprCtl.hpp"
+
+// what binds and scripts send the most
+const std::vector<std::pair<std::string, std::string>> COMMANDS = {
+    {"workspace", "3"},          {"workspace", "+1"},         {"workspace", "m-1"},          {"workspace", "name:web"}, {"movetoworkspace", "special"},
+    {"movetoworkspacesilent", "5"}, {"movefocus", "l"},       {"movewindow", "r"},           {"splitratio", "-0.1"},    {"resizeactive", "20 -20"},
+    {"workspaceopt", "allfloat"}, {"exec", "kitty"},          {"togglefloating", ""},        {"killactive", ""},        {"workspace", "garbage"},
+};
+
+// how dispatchBatch used to split: the rest of the request copied once per command
+size_t oldBatchSplit(std::string request) {
+    size_t commands = 0;
+
+    request = request.substr(9);
+    while (!request.empty()) {
+        const auto IDX = request.find_first_of(';');
+        commands += !removeBeginEndSpacesTabs(IDX == std::string::npos ? request : request.substr(0, IDX)).empty();
+        request = IDX == std::string::npos ? "" : request.substr(IDX + 1);
+    }
+
+    return commands;
+}
+
+int main() {
+    startHeadless();
+
+    // endBatch flushes the held back events, nobody's listening
+    g_pEventManager = std::make_unique<CEventManager>();
+
+    CKeybindManager keybinds;
+
+    constexpr size_t DISPATCHES = 100000;
+
+    const auto COMPILE = benchmarkNs(DISPATCHES, [&](size_t i) {
+        const auto& [HANDLER, ARG] = COMMANDS[i % COMMANDS.size()];
+        doNotOptimize(keybinds.compileDispatch(HANDLER, ARG).op);
+    });
+
+    const auto PARSE = benchmarkNs(DISPATCHES, [&](size_t i) { doNotOptimize(parseWorkspaceTarget(COMMANDS[i % 5].second).type); });
+
+    printBenchmark("compileDispatch, mixed commands", COMPILE);
+    printBenchmark("parseWorkspaceTarget, mixed targets", PARSE);
+    printf("%-48s %12.1f ms\n", "100k dispatches compiled", COMPILE * DISPATCHES / 1000000.0);
+
+    // a script's [[BATCH]] of 100k commands. Without a focused window the dispatchers return right away, so this
+    // is the splitting, the compiled dispatch lookups and the batch itself.
+    std::string batch = "[[BATCH]]";
+    for (size_t i = 0; i < DISPATCHES; ++i)
+        batch += i % 2 ? "dispatch splitratio 0.1 ; " : "dispatch splitratio -0.1 ; ";
+
+    // the old split copies ~130GB for 100k, a tenth of it shows the curve well enough
+    const auto SMALLBATCH = batch.substr(0, batch.length() / 10);
+
+    const auto BATCH = benchmarkNs(5, [&](size_t i) { doNotOptimize(HyprCtl::getReply(batch).length()); });
+    const auto SMALLSPLIT = benchmarkNs(5, [&](size_t i) { doNotOptimize(oldBatchSplit(SMALLBATCH)); });
+
+    printf("%-48s %12.1f ms\n", "[[BATCH]] of 100k dispatches", BATCH / 1000000.0);
+    printf("%-48s %12.1f ms\n", "10k commands split the old way", SMALLSPLIT / 1000000.0);
+
+    g_pEventManager.reset();
+    stopHeadless();
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include "shared.hpp"
+#include "headless.hpp"
+#include "../src/debug/HyprCtl.hpp"
+
+int main() {
+    startHeadless();
+
+    const auto PMONITOR = addHeadlessMonitor(Vector2D(0, 0), Vector2D(1920, 1080));
+
+    // what a bar polling "clients" sees on a busy session
+    for (int i = 0; i < 500; ++i) {
+        const auto PWINDOW = addHeadlessWindow(PMONITOR, Vector2D((i * 37) % 1600, (i * 23) % 900), Vector2D(320, 180), i % 4 == 0);
+        PWINDOW->m_szTitle = "~/src/hyprland - nvim (" + std::to_string(i) + ")";
+    }
+
+    const auto NORMAL = benchmarkNs(1000, [&](size_t i) { doNotOptimize(HyprCtl::getReply("clients").length()); });
+    const auto JSON = benchmarkNs(1000, [&](size_t i) { doNotOptimize(HyprCtl::getReply("j/clients").length()); });
+    const auto BINARY = benchmarkNs(1000, [&](size_t i) { doNotOptimize(HyprCtl::getReply("b/clients").length()); });
+
+    printBenchmark("clients, 500 windows, text", NORMAL);
+    printBenchmark("clients, 500 windows, json", JSON);
+    printBenchmark("clients, 500 windows, binary", BINARY);
+
+    stopHeadless();
+
+    return 0;
+}
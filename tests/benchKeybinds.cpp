@@ -0,0 +1,51 @@
+#include "shared.hpp"
+#include "../src/managers/KeybindManager.hpp"
+
+const std::vector<std::string> KEYS = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y",
+                                       "z", "1", "2", "3", "4", "5", "6", "7", "8", "9", "0", "F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12", "Return", "space"};
+const std::vector<uint32_t> MODS = {WLR_MODIFIER_LOGO, WLR_MODIFIER_LOGO | WLR_MODIFIER_SHIFT, WLR_MODIFIER_LOGO | WLR_MODIFIER_CTRL, WLR_MODIFIER_ALT};
+
+int main() {
+    for (const size_t BINDS : {20, 200}) {
+        CKeybindManager keybinds;
+        std::vector<SKeybind> plain; // for the old walk over every bind
+
+        for (size_t i = 0; i < BINDS; ++i) {
+            SKeybind kb = {.key = KEYS[i % KEYS.size()], .modmask = MODS[(i / KEYS.size()) % MODS.size()], .handler = "workspace", .arg = std::to_string(i % 10 + 1)};
+            plain.push_back(kb);
+            keybinds.addKeybind(kb);
+        }
+
+        const auto BOUNDSYM = xkb_keysym_from_name(plain.back().key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+        const auto BOUNDMOD = plain.back().modmask;
+        const auto UNBOUNDSYM = XKB_KEY_Menu; // what most key presses are: typing into a window
+
+        const auto HIT = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(keybinds.getKeybindsFor(BOUNDMOD, BOUNDSYM)); });
+        const auto MISS = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(keybinds.getKeybindsFor(0, UNBOUNDSYM)); });
+
+        // what handleKeybinds did before the table: resolve every bind's keysym by name on every press
+        const auto OLDMISS = benchmarkNs(10000, [&](size_t i) {
+            for (auto& k : plain) {
+                if (k.modmask != 0)
+                    continue;
+
+                doNotOptimize(xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE));
+            }
+        });
+        const auto OLDHIT = benchmarkNs(10000, [&](size_t i) {
+            for (auto& k : plain) {
+                if (k.modmask != BOUNDMOD)
+                    continue;
+
+                doNotOptimize(xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE) == BOUNDSYM);
+            }
+        });
+
+        printBenchmark(("key lookup, " + std::to_string(BINDS) + " binds, bound key").c_str(), HIT);
+        printBenchmark(("key lookup, " + std::to_string(BINDS) + " binds, unbound key").c_str(), MISS);
+        printBenchmark(("linear walk, " + std::to_string(BINDS) + " binds, bound key").c_str(), OLDHIT);
+        printBenchmark(("linear walk, " + std::to_string(BINDS) + " binds, unbound key").c_str(), OLDMISS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "shared.hpp"
+#include "../src/debug/Log.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// average and worst time a Debug::log call keeps the caller, which is the main thread in the compositor
+void benchLevel(LogLevel level, const char* name, size_t calls, double* average, double* worst) {
+    *worst = 0;
+
+    *average = benchmarkNs(calls, [&](size_t i) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        Debug::log(level, "Window %p -> %s: at %i,%i size %i,%i on workspace %i", (void*)0x5555deadbeef, name, (int)i % 1920, (int)i % 1080, 800, 600, (int)i % 10);
+        *worst = std::max(*worst, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - BEGIN).count());
+    });
+}
+
+int main() {
+    const std::string INSTANCEDIR = "/tmp/hypr/bench_" + std::to_string(getpid());
+    mkdir("/tmp/hypr", S_IRWXU | S_IRWXG);
+    mkdir(INSTANCEDIR.c_str(), S_IRWXU | S_IRWXG);
+
+    // the log thread echoes everything to stdout, keep that out of the results
+    const auto STDOUTFD = dup(STDOUT_FILENO);
+    const auto DEVNULL = open("/dev/null", O_WRONLY);
+    fflush(stdout);
+    dup2(DEVNULL, STDOUT_FILENO);
+
+    Debug::init(INSTANCEDIR.substr(strlen("/tmp/hypr/")));
+
+    double logAverage = 0, logWorst = 0, errAverage = 0, errWorst = 0;
+    benchLevel(LOG, "LOG", 200000, &logAverage, &logWorst);
+    benchLevel(ERR, "ERR", 20000, &errAverage, &errWorst);
+
+    Debug::flush();
+    dup2(STDOUTFD, STDOUT_FILENO);
+
+    printBenchmark("Debug::log, LOG, average", logAverage);
+    printBenchmark("Debug::log, LOG, worst", logWorst);
+    printf("%-48s %12.0f calls/s\n", "Debug::log, LOG", 1000000000.0 / logAverage);
+    printBenchmark("Debug::log, ERR, average", errAverage);
+    printBenchmark("Debug::log, ERR, worst", errWorst);
+    printf("%-48s %12.0f calls/s\n", "Debug::log, ERR", 1000000000.0 / errAverage);
+
+    unlink(Debug::logFile.c_str());
+    rmdir(INSTANCEDIR.c_str());
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+constexpr int MONITORS = 4;
+constexpr int WINDOWS = 200;
+
+int main() {
+    startHeadless();
+
+    std::vector<SMonitor*> monitors;
+    for (int i = 0; i < MONITORS; ++i)
+        monitors.push_back(addHeadlessMonitor(Vector2D(i * 1920, 0), Vector2D(1920, 1080)));
+
+    // half of them on workspaces nobody's looking at
+    for (int i = 0; i < WINDOWS; ++i) {
+        const auto PMONITOR = monitors[i % MONITORS];
+        const auto PWINDOW = addHeadlessWindow(PMONITOR, PMONITOR->vecPosition + Vector2D((i * 37) % 1600, (i * 23) % 900), Vector2D(320, 180), i % 4 == 0);
+
+        if (i % 2)
+            PWINDOW->m_iWorkspaceID = PMONITOR->activeWorkspace + 10;
+    }
+    g_pCompositor->invalidateWindowIndex();
+
+    // a frame on every monitor, with nothing but buffers and positions changing
+    const auto VALID = benchmarkNs(100000, [&](size_t i) {
+        for (auto& m : monitors)
+            g_pHyprRenderer->prepareRenderList(m);
+    });
+
+    // what every frame paid while damage threw the lists away
+    const auto REBUILT = benchmarkNs(100000, [&](size_t i) {
+        g_pHyprRenderer->invalidateRenderLists();
+        for (auto& m : monitors)
+            g_pHyprRenderer->prepareRenderList(m);
+    });
+
+    printBenchmark("prepareRenderList, 4 monitors, 200 windows", VALID);
+    printBenchmark("prepareRenderList, 4 monitors, rebuilt", REBUILT);
+
+    stopHeadless();
+
+    return 0;
+}
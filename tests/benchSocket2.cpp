@@ -0,0 +1,146 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+constexpr size_t CLIENTS = 50;
+
+// 50 listeners like bars and scripts, all read by one thread, which counts the events that reach each
+std::vector<int>                 clientFDs;
+std::vector<std::atomic<size_t>> received(CLIENTS);
+std::atomic<bool>                stopReading = false;
+
+void readClients() {
+    std::vector<pollfd> pollFDs;
+    for (const auto& fd : clientFDs)
+        pollFDs.push_back({fd, POLLIN, 0});
+
+    char buf[65536];
+
+    while (!stopReading) {
+        if (poll(pollFDs.data(), pollFDs.size(), 10) <= 0)
+            continue;
+
+        for (size_t i = 0; i < pollFDs.size(); ++i) {
+            if (!(pollFDs[i].revents & POLLIN))
+                continue;
+
+            const auto SIZEREAD = read(pollFDs[i].fd, buf, sizeof(buf));
+            size_t     lines = 0;
+            for (ssize_t j = 0; j < SIZEREAD; ++j)
+                lines += buf[j] == '\n';
+
+            received[i] += lines;
+        }
+    }
+}
+
+size_t minReceived() {
+    size_t min = SIZE_MAX;
+    for (const auto& r : received)
+        min = std::min(min, r.load());
+    return min;
+}
+
+void waitForAll(size_t count) {
+    while (minReceived() < count)
+        std::this_thread::yield();
+}
+
+int main() {
+    startHeadless();
+
+    // its own instance dir, so it can run next to a real session and other runs
+    g_pCompositor->m_szInstanceSignature = "bench_" + std::to_string(getpid());
+    mkdir("/tmp/hypr", S_IRWXU | S_IRWXG);
+    mkdir(("/tmp/hypr/" + g_pCompositor->m_szInstanceSignature).c_str(), S_IRWXU | S_IRWXG);
+    const std::string SOCKETPATH = "/tmp/hypr/" + g_pCompositor->m_szInstanceSignature + "/.socket2.sock";
+
+    // the socket thread is detached and outlives main, so the manager is never freed
+    g_pEventManager = std::make_unique<CEventManager>();
+    g_pEventManager->startThread();
+
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        const auto   FD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un  address = {.sun_family = AF_UNIX};
+        strcpy(address.sun_path, SOCKETPATH.c_str());
+
+        // the thread might not be listening yet
+        while (connect(FD, (sockaddr*)&address, SUN_LEN(&address)) < 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        clientFDs.push_back(FD);
+    }
+
+    std::thread reader(readClients);
+
+    // until every client got accepted and hears us
+    size_t expected = 0;
+    while (minReceived() == 0) {
+        g_pEventManager->postEvent(SHyprIPCEvent{"warmup", ""});
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // the last warmups are still on their way
+    for (auto& r : received)
+        r = 0;
+
+    // what the main thread pays, the writing is the socket thread's
+    const auto POST = benchmarkNs(1000, [&](size_t i) { g_pEventManager->postEvent(SHyprIPCEvent{"activewindow", "kitty,~/src/hyprland"}); });
+    expected += 1000;
+    waitForAll(expected);
+
+    // one event until all 50 have it
+    double worstNs = 0;
+    const auto LATENCY = benchmarkNs(1000, [&](size_t i) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        g_pEventManager->postEvent(SHyprIPCEvent{"activewindow", "kitty,~/src/hyprland"});
+        waitForAll(++expected);
+        worstNs = std::max(worstNs, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - BEGIN).count());
+    });
+
+    // bursts of 100, like a workspace switch with a full workspace
+    const auto BURST = benchmarkNs(100, [&](size_t i) {
+        for (int j = 0; j < 100; ++j)
+            g_pEventManager->postEvent(SHyprIPCEvent{"openwindow", "80a6f50,2,kitty,kitty"});
+
+        expected += 100;
+        waitForAll(expected);
+    });
+
+    // the same burst from a [[BATCH]], one wakeup for all of it
+    const auto BATCHED = benchmarkNs(100, [&](size_t i) {
+        g_pCompositor->beginBatch();
+        for (int j = 0; j < 100; ++j)
+            g_pEventManager->postEvent(SHyprIPCEvent{"openwindow", "80a6f50,2,kitty,kitty"});
+        g_pCompositor->endBatch();
+
+        expected += 100;
+        waitForAll(expected);
+    });
+
+    printBenchmark("postEvent, 50 clients", POST);
+    printBenchmark("event delivered to 50 clients, average", LATENCY);
+    printBenchmark("event delivered to 50 clients, worst", worstNs);
+    printBenchmark("100 events delivered to 50 clients", BURST);
+    printBenchmark("100 batched events delivered to 50 clients", BATCHED);
+
+    stopReading = true;
+    reader.join();
+
+    for (const auto& fd : clientFDs)
+        close(fd);
+
+    unlink(SOCKETPATH.c_str());
+    rmdir(("/tmp/hypr/" + g_pCompositor->m_szInstanceSignature).c_str());
+
+    stopHeadless();
+
+    return 0;
+}
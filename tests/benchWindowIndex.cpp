@@ -0,0 +1,67 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+// windows spread over 10 workspaces, one of them shown on the monitor. Every 4th window floats.
+void addWindows(SMonitor* pMonitor, int count) {
+    for (int i = 0; i < count; ++i) {
+        const auto PWINDOW = addHeadlessWindow(pMonitor, Vector2D((i * 37) % 1600, (i * 23) % 900), Vector2D(320, 180), i % 4 == 0);
+        PWINDOW->m_iWorkspaceID = i % 10 + 1;
+    }
+}
+
+int main() {
+    startHeadless();
+
+    const auto PMONITOR = addHeadlessMonitor(Vector2D(0, 0), Vector2D(1920, 1080));
+
+    for (const int WINDOWS : {10, 100, 1000}) {
+        addWindows(PMONITOR, WINDOWS - g_pCompositor->m_lWindows.size());
+
+        // a point some windows cover, and one in the corner nothing does
+        const auto COVERED = Vector2D(400, 300);
+        const auto EMPTY = Vector2D(1919, 1079);
+
+        const auto BUCKET = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(g_pCompositor->getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace).size()); });
+        const auto HIT = benchmarkNs(100000, [&](size_t i) { doNotOptimize(g_pCompositor->vectorToWindow(COVERED)); });
+        const auto MISS = benchmarkNs(100000, [&](size_t i) { doNotOptimize(g_pCompositor->vectorToWindow(EMPTY)); });
+
+        // pointer focus asks this for every surface under the cursor, most of them aren't windows
+        wlr_surface notAWindow = {};
+        const auto SURFACEHIT = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(g_pCompositor->getWindowFromSurface(g_pXWaylandManager->getWindowSurface(&g_pCompositor->m_lWindows.back()))); });
+        const auto SURFACEMISS = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(g_pCompositor->getWindowFromSurface(&notAWindow)); });
+
+        g_pCompositor->m_sWLRCursor->x = COVERED.x;
+        g_pCompositor->m_sWLRCursor->y = COVERED.y;
+        const auto FLOATING = benchmarkNs(100000, [&](size_t i) { doNotOptimize(g_pCompositor->windowFloatingFromCursor()); });
+
+        // what the hit-tests did before the index: walk every window back to front
+        const auto OLDMISS = benchmarkNs(100000, [&](size_t i) {
+            for (auto w = g_pCompositor->m_lWindows.rbegin(); w != g_pCompositor->m_lWindows.rend(); ++w) {
+                wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+                if (w->m_bIsFloating && w->m_bIsMapped && g_pCompositor->isWorkspaceVisible(w->m_iWorkspaceID) && wlr_box_contains_point(&box, EMPTY.x, EMPTY.y)) {
+                    doNotOptimize(&*w);
+                    break;
+                }
+            }
+        });
+
+        // the first lookup after a map / unmap pays for the rebuild
+        const auto REBUILD = benchmarkNs(WINDOWS >= 1000 ? 1000 : 10000, [&](size_t i) {
+            g_pCompositor->invalidateWindowIndex();
+            doNotOptimize(g_pCompositor->getIndexedWindowsOnWorkspace(PMONITOR->activeWorkspace).size());
+        });
+
+        printBenchmark(("workspace bucket, " + std::to_string(WINDOWS) + " windows").c_str(), BUCKET);
+        printBenchmark(("vectorToWindow, " + std::to_string(WINDOWS) + " windows, hit").c_str(), HIT);
+        printBenchmark(("vectorToWindow, " + std::to_string(WINDOWS) + " windows, miss").c_str(), MISS);
+        printBenchmark(("floating window at cursor, " + std::to_string(WINDOWS) + " windows").c_str(), FLOATING);
+        printBenchmark(("window from surface, " + std::to_string(WINDOWS) + " windows, hit").c_str(), SURFACEHIT);
+        printBenchmark(("window from surface, " + std::to_string(WINDOWS) + " windows, miss").c_str(), SURFACEMISS);
+        printBenchmark(("linear walk, " + std::to_string(WINDOWS) + " windows, miss").c_str(), OLDMISS);
+        printBenchmark(("index rebuild, " + std::to_string(WINDOWS) + " windows").c_str(), REBUILD);
+    }
+
+    stopHeadless();
+
+    return 0;
+}
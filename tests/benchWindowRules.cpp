@@ -0,0 +1,39 @@
+#include "shared.hpp"
+#include "../src/config/ConfigManager.hpp"
+#include "../src/managers/KeybindManager.hpp"
+
+// rules like a big config has them: a third are plain strings, the rest regexes on class or title
+void addRules(CConfigManager* pConfig, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (i % 3 == 0)
+            pConfig->parseKeyword("windowrule", "float,app" + std::to_string(i));
+        else if (i % 3 == 1)
+            pConfig->parseKeyword("windowrule", "opacity 0.9,^(org\\.app" + std::to_string(i) + ")$");
+        else
+            pConfig->parseKeyword("windowrule", "workspace 2,.*Title " + std::to_string(i) + ".*");
+    }
+}
+
+int main() {
+    // setDefaultVars() asks the keybind manager for the main mod
+    g_pKeybindManager = std::make_unique<CKeybindManager>();
+
+    for (const int RULES : {10, 100, 1000}) {
+        CConfigManager config;
+        addRules(&config, RULES);
+
+        const std::string CLASS = "org.app1";
+        const std::string TITLE = "Some Title 2 - Editor";
+
+        // a new title every time, as with a terminal or a browser, always a cache miss
+        const auto MISS = benchmarkNs(RULES >= 1000 ? 2000 : 20000, [&](size_t i) { doNotOptimize(config.getMatchingRuleIndices(TITLE + std::to_string(i), CLASS).size()); });
+
+        // remaps, focus changes etc. of the same window
+        const auto HIT = benchmarkNs(1000000, [&](size_t i) { doNotOptimize(config.getMatchingRuleIndices(TITLE, CLASS).size()); });
+
+        printBenchmark(("rule matching, " + std::to_string(RULES) + " rules, new title").c_str(), MISS);
+        printBenchmark(("rule matching, " + std::to_string(RULES) + " rules, cached").c_str(), HIT);
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <list>
+#include "../src/Compositor.hpp"
+
+// A compositor without a display, for everything that only works on the window / workspace / monitor lists.
+// Monitors, workspaces and windows are made up: they have no wlr_output, and the windows' surfaces are zeroed
+// wlroots structs that nothing but the surface lookups ever looks at.
+
+struct SHeadlessSurface {
+    wlr_xdg_surface  xdg = {};
+    wlr_xdg_toplevel toplevel = {};
+    wlr_surface      surface = {};
+};
+
+inline std::list<SHeadlessSurface> headlessSurfaces;
+
+inline void startHeadless() {
+    g_pCompositor = std::make_unique<CCompositor>(CCompositor::SHeadless{});
+
+    // setDefaultVars() asks the keybind manager for the main mod
+    g_pKeybindManager = std::make_unique<CKeybindManager>();
+    g_pConfigManager = std::make_unique<CConfigManager>();
+    g_pAnimationManager = std::make_unique<CAnimationManager>();
+    g_pXWaylandManager = std::make_unique<CHyprXWaylandManager>();
+    g_pLayoutManager = std::make_unique<CLayoutManager>();
+    g_pHyprRenderer = std::make_unique<CHyprRenderer>();
+}
+
+// windows and workspaces unregister from the managers and look at g_pCompositor when they go, so they go first
+inline void stopHeadless() {
+    g_pCompositor->m_lWindows.clear();
+    g_pCompositor->m_lWorkspaces.clear();
+    g_pCompositor->m_lMonitors.clear();
+    headlessSurfaces.clear();
+
+    wlr_cursor_destroy(g_pCompositor->m_sWLRCursor);
+    wlr_output_layout_destroy(g_pCompositor->m_sWLROutputLayout);
+
+    g_pHyprRenderer.reset();
+    g_pLayoutManager.reset();
+    g_pXWaylandManager.reset();
+    g_pAnimationManager.reset();
+    g_pConfigManager.reset();
+    g_pKeybindManager.reset();
+    g_pCompositor.reset();
+}
+
+// a monitor showing workspace ID + 1, which gets created with it
+inline SMonitor* addHeadlessMonitor(const Vector2D& pos, const Vector2D& size, float scale = 1.f) {
+    const auto PMONITOR = &g_pCompositor->m_lMonitors.emplace_back();
+    PMONITOR->ID = g_pCompositor->getNextAvailableMonitorID();
+    PMONITOR->szName = "HEADLESS-" + std::to_string(PMONITOR->ID);
+    PMONITOR->vecPosition = pos;
+    PMONITOR->vecSize = size;
+    PMONITOR->scale = scale;
+    PMONITOR->vecPixelSize = size * scale;
+    PMONITOR->vecTransformedSize = size * scale;
+    PMONITOR->activeWorkspace = PMONITOR->ID + 1;
+    g_pCompositor->invalidateMonitorIndex();
+
+    const auto PWORKSPACE = &g_pCompositor->m_lWorkspaces.emplace_back(PMONITOR->ID);
+    PWORKSPACE->m_iID = PMONITOR->activeWorkspace;
+    PWORKSPACE->m_szName = std::to_string(PWORKSPACE->m_iID);
+    g_pCompositor->invalidateWorkspaceIndex();
+
+    return PMONITOR;
+}
+
+// a mapped xdg window, on top of the stack
+inline CWindow* addHeadlessWindow(SMonitor* pMonitor, const Vector2D& pos, const Vector2D& size, bool floating = false) {
+    const auto PSURFACE = &headlessSurfaces.emplace_back();
+    PSURFACE->xdg.surface = &PSURFACE->surface;
+    PSURFACE->xdg.toplevel = &PSURFACE->toplevel;
+    PSURFACE->toplevel.app_id = (char*)"headless";
+
+    const auto PWINDOW = &g_pCompositor->m_lWindows.emplace_back();
+    PWINDOW->m_uSurface.xdg = &PSURFACE->xdg;
+    PWINDOW->m_iMonitorID = pMonitor->ID;
+    PWINDOW->m_iWorkspaceID = pMonitor->activeWorkspace;
+    PWINDOW->m_bIsMapped = true;
+    PWINDOW->m_bIsFloating = floating;
+    PWINDOW->m_vPosition = pos;
+    PWINDOW->m_vSize = size;
+    PWINDOW->m_vRealPosition.setValueAndWarp(pos);
+    PWINDOW->m_vRealSize.setValueAndWarp(size);
+    PWINDOW->m_fAlpha.setValueAndWarp(255.f);
+    g_pCompositor->invalidateWindowIndex();
+
+    return PWINDOW;
+}
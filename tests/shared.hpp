@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// a failed EXPECT prints where and why, the test then keeps going and main() returns the failure count
+inline int testFailures = 0;
+
+#define EXPECT(expr, format, ...) \
+    if (!(expr)) { \
+        fprintf(stderr, "FAILED: %s at line %d in %s: " format "\n", #expr, __LINE__, __FILE__, ##__VA_ARGS__); \
+        testFailures++; \
+    }
+
+// keeps the compiler from dropping a result we only compute to time it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// runs fn ITERATIONS times and returns the average in ns
+template <typename F>
+inline double benchmarkNs(size_t ITERATIONS, F&& fn) {
+    const auto BEGIN = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < ITERATIONS; ++i)
+        fn(i);
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / (double)ITERATIONS;
+}
+
+inline void printBenchmark(const char* name, double ns) {
+    printf("%-48s %12.1f ns\n", name, ns);
+}
@@ -0,0 +1,80 @@
+#include "shared.hpp"
+#include "../src/helpers/BezierCurve.hpp"
+
+#include <cmath>
+
+// y for x on the exact curve, in double precision, by bisecting x(t). Needs x(t) to be monotonic, like every css-style ease.
+double referenceY(const Vector2D& p1, const Vector2D& p2, double x) {
+    const auto BEZIER = [](double a, double b, double t) { return 3 * a * t * (1 - t) * (1 - t) + 3 * b * t * t * (1 - t) + t * t * t; };
+
+    double lower = 0, upper = 1;
+    for (int i = 0; i < 64; ++i) {
+        const double MID = (lower + upper) / 2.0;
+
+        if (BEZIER(p1.x, p2.x, MID) < x)
+            lower = MID;
+        else
+            upper = MID;
+    }
+
+    return BEZIER(p1.y, p2.y, (lower + upper) / 2.0);
+}
+
+void testCurve(const char* name, Vector2D p1, Vector2D p2, double maxError) {
+    std::vector<Vector2D> points = {p1, p2};
+
+    CBezierCurve curve;
+    curve.setup(&points);
+
+    constexpr int SAMPLES = 100000;
+
+    double worst = 0, worstX = 0;
+    for (int i = 0; i <= SAMPLES; ++i) {
+        const double X = i / (double)SAMPLES;
+        const double ERROR = std::abs(curve.getYForPoint(X) - referenceY(p1, p2, X));
+
+        if (ERROR > worst) {
+            worst = ERROR;
+            worstX = X;
+        }
+    }
+
+    EXPECT(worst < maxError, "%s: error %.3e at x = %.5f, allowed %.1e", name, worst, worstX, maxError);
+
+    // right on the baked points the newton steps get clamped to a segment edge, they have to stay exact there
+    for (int i = 0; i < BAKEDPOINTS; ++i) {
+        const float X = curve.getXForT(i / (float)(BAKEDPOINTS - 1));
+
+        if (X <= 0.f || X >= 1.f)
+            continue;
+
+        const double ERROR = std::abs(curve.getYForPoint(X) - referenceY(p1, p2, X));
+        EXPECT(ERROR < maxError, "%s: error %.3e on baked point %d (x = %.5f)", name, ERROR, i, X);
+    }
+
+    // out of range gets clamped to the ends
+    EXPECT(curve.getYForPoint(-0.5f) == 0.f, "%s: x < 0 should give 0", name);
+    EXPECT(curve.getYForPoint(0.f) == 0.f, "%s: x = 0 should give 0", name);
+    EXPECT(curve.getYForPoint(1.f) == 1.f, "%s: x = 1 should give 1", name);
+    EXPECT(curve.getYForPoint(1.5f) == 1.f, "%s: x > 1 should give 1", name);
+}
+
+int main() {
+    // the default curve
+    testCurve("default", Vector2D(0.0, 0.75), Vector2D(0.15, 1.0), 2.5e-5);
+
+    // the usual eases
+    testCurve("linear", Vector2D(0.0, 0.0), Vector2D(1.0, 1.0), 1e-6);
+    testCurve("ease", Vector2D(0.25, 0.1), Vector2D(0.25, 1.0), 1e-6);
+    testCurve("ease-in", Vector2D(0.42, 0.0), Vector2D(1.0, 1.0), 1e-6);
+    testCurve("ease-out", Vector2D(0.0, 0.0), Vector2D(0.58, 1.0), 1e-6);
+    testCurve("ease-in-out", Vector2D(0.42, 0.0), Vector2D(0.58, 1.0), 1e-6);
+
+    // overshoot, y leaves [0, 1]
+    testCurve("overshot", Vector2D(0.05, 0.9), Vector2D(0.1, 1.05), 2.5e-5);
+
+    // x(t) goes flat in the middle, newton has to stay inside its segment there
+    testCurve("flat middle", Vector2D(0.9, 0.1), Vector2D(0.1, 0.9), 2.5e-5);
+
+    return testFailures;
+}
@@ -0,0 +1,220 @@
+#include "shared.hpp"
+#include "../src/render/FramePrep.hpp"
+#include "../src/helpers/WorkerPool.hpp"
+
+// a 1920x1080 monitor at 1920,0, scale 1, the whole of it damaged
+void setupMonitor(SFramePrep& prep) {
+    prep.reset();
+    prep.monitorPosition = Vector2D(1920, 0);
+    prep.scale = 1.f;
+    prep.width = 1920;
+    prep.height = 1080;
+    prep.blurRadius = 20;
+    prep.occlude = true;
+    pixman_region32_union_rect(&prep.damage, &prep.damage, 0, 0, 1920, 1080);
+}
+
+// a surface at x,y (monitor-local) of w x h, opaque all over
+SPrepSurface& addOpaque(SFramePrep& prep, void* pOwner, int x, int y, int w, int h) {
+    auto& surface = prep.addSurface(pOwner);
+    surface.box = {x, y, w, h};
+    surface.hasOpaque = true;
+    pixman_region32_union_rect(&surface.opaque, &surface.opaque, 0, 0, w, h);
+    surface.opaquePos = Vector2D(x + 1920, y);
+    surface.opaqueBox = surface.box;
+    return surface;
+}
+
+SPrepSurface& addTranslucent(SFramePrep& prep, void* pOwner, int x, int y, int w, int h) {
+    auto& surface = prep.addSurface(pOwner);
+    surface.box = {x, y, w, h};
+    return surface;
+}
+
+long area(pixman_region32_t* pRegion) {
+    long total = 0;
+    int rectsNum = 0;
+    const auto RECTS = pixman_region32_rectangles(pRegion, &rectsNum);
+    for (int i = 0; i < rectsNum; ++i)
+        total += (long)(RECTS[i].x2 - RECTS[i].x1) * (RECTS[i].y2 - RECTS[i].y1);
+    return total;
+}
+
+int main() {
+    int owners[8];
+    SFramePrep prep;
+
+    // fully behind an opaque window: culled, all of it occluded
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 100, 100, 800, 600);
+        addTranslucent(prep, &owners[1], 200, 200, 400, 300);
+        prepareFrame(prep);
+
+        EXPECT(!prep.surfaces[0].culled && area(&prep.surfaces[0].visible) == 1920 * 1080, "the front one lost damage");
+        EXPECT(prep.surfaces[1].culled, "the covered one isn't culled");
+        EXPECT(!pixman_region32_not_empty(&prep.surfaces[1].visible), "the covered one has damage left");
+        EXPECT(prep.surfaces[1].pixelsOccluded == 400 * 300, "%ld px occluded, expected %d", prep.surfaces[1].pixelsOccluded, 400 * 300);
+    }
+
+    // partly covered: what sticks out stays
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 0, 0, 500, 1080);
+        addTranslucent(prep, &owners[1], 400, 0, 200, 100);
+        prepareFrame(prep);
+
+        EXPECT(!prep.surfaces[1].culled, "a partly covered one got culled");
+        EXPECT(prep.surfaces[1].pixelsOccluded == 100 * 100, "%ld px occluded, expected %d", prep.surfaces[1].pixelsOccluded, 100 * 100);
+    }
+
+    // one with popups is never culled
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 100, 100, 800, 600);
+        addTranslucent(prep, &owners[1], 200, 200, 400, 300).canCull = false;
+        prepareFrame(prep);
+
+        EXPECT(!prep.surfaces[1].culled, "one with popups got culled");
+        EXPECT(pixman_region32_not_empty(&prep.surfaces[1].visible), "one with popups lost the damage outside its box");
+    }
+
+    // a blurring window in front punches its blur area, radius included, out of what's opaque further in front
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 0, 0, 1920, 1080);
+        auto& blurring = addTranslucent(prep, &owners[1], 100, 100, 400, 300);
+        blurring.blurs = true;
+        blurring.blurBox = blurring.box;
+        addTranslucent(prep, &owners[2], 50, 50, 600, 500);
+        prepareFrame(prep);
+
+        // the fullscreen opaque one still covers the blurring one itself
+        EXPECT(prep.surfaces[1].culled, "the blurring one behind a fullscreen opaque isn't culled");
+        EXPECT(!prep.surfaces[2].culled, "what the blur samples got culled");
+        EXPECT(area(&prep.surfaces[2].visible) == 440 * 340, "%ld px visible behind the blur, expected %d", area(&prep.surfaces[2].visible), 440 * 340);
+    }
+
+    // nothing in front of the static blur cache may cut into it
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 0, 0, 1920, 1080);
+        prep.firstBelowBlurCache = prep.surfaces.size();
+        addTranslucent(prep, &owners[1], 0, 0, 1920, 30);
+        prepareFrame(prep);
+
+        EXPECT(!prep.surfaces[1].culled && prep.surfaces[1].pixelsOccluded == 0, "the blur cache got occluded");
+    }
+
+    // rounded corners let through what's below
+    {
+        setupMonitor(prep);
+        addOpaque(prep, &owners[0], 0, 0, 1920, 1080).rounding = 10;
+        addTranslucent(prep, &owners[1], 0, 0, 5, 5);
+        addTranslucent(prep, &owners[2], 500, 500, 5, 5);
+        prepareFrame(prep);
+
+        EXPECT(!prep.surfaces[1].culled, "the corner got culled");
+        EXPECT(prep.surfaces[2].culled, "the middle isn't culled");
+    }
+
+    // the opaque region is snapshotted surface-local, in layout coords
+    {
+        setupMonitor(prep);
+        prep.scale = 2.f;
+        auto& front = prep.addSurface(&owners[0]);
+        front.box = {0, 0, 200, 200};
+        front.hasOpaque = true;
+        pixman_region32_union_rect(&front.opaque, &front.opaque, 0, 0, 100, 100);
+        front.opaquePos = Vector2D(1920 + 50, 0);
+        front.opaqueBox = {100, 0, 200, 200};
+        addTranslucent(prep, &owners[1], 100, 0, 200, 200);
+        addTranslucent(prep, &owners[2], 0, 0, 100, 100);
+        prepareFrame(prep);
+
+        EXPECT(prep.surfaces[1].culled, "the surface under the scaled opaque one isn't culled");
+        EXPECT(!prep.surfaces[2].culled, "the surface left of it got culled");
+    }
+
+    // the damage grows around blurring windows only, and not past what they sample
+    {
+        setupMonitor(prep);
+        pixman_region32_clear(&prep.damage);
+        pixman_region32_union_rect(&prep.damage, &prep.damage, 500, 500, 10, 10);
+        prep.expandForBlur = true;
+        auto& blurring = addTranslucent(prep, &owners[0], 400, 400, 400, 400);
+        blurring.blurs = true;
+        blurring.blurBox = blurring.box;
+        prepareFrame(prep);
+
+        EXPECT(area(&prep.damage) == 50 * 50, "damage is %ld px after expanding, expected %d", area(&prep.damage), 50 * 50);
+
+        setupMonitor(prep);
+        pixman_region32_clear(&prep.damage);
+        pixman_region32_union_rect(&prep.damage, &prep.damage, 1500, 900, 10, 10);
+        prep.expandForBlur = true;
+        auto& far = addTranslucent(prep, &owners[0], 0, 0, 400, 400);
+        far.blurs = true;
+        far.blurBox = far.box;
+        prepareFrame(prep);
+
+        EXPECT(area(&prep.damage) == 10 * 10, "damage far from any blur grew to %ld px", area(&prep.damage));
+    }
+
+    // no damage, nothing to occlude
+    {
+        setupMonitor(prep);
+        pixman_region32_clear(&prep.damage);
+        addOpaque(prep, &owners[0], 0, 0, 100, 100);
+        prepareFrame(prep);
+
+        EXPECT(!prep.occlude, "occluding without damage");
+
+        // unless the whole monitor gets redrawn anyways
+        setupMonitor(prep);
+        pixman_region32_clear(&prep.damage);
+        prep.fullDamage = true;
+        prepareFrame(prep);
+
+        EXPECT(prep.occlude && area(&prep.damage) == 1920 * 1080, "fullDamage didn't damage the monitor");
+    }
+
+    // split over the pool like the renderer does, the same as on one thread
+    {
+        const auto FILL = [&](SFramePrep& p) {
+            setupMonitor(p);
+            for (int i = 0; i < 100; ++i) {
+                if (i % 3 == 0) {
+                    auto& blurring = addTranslucent(p, &owners[i % 8], (i * 97) % 1700, (i * 53) % 900, 200, 150);
+                    blurring.blurs = true;
+                    blurring.blurBox = blurring.box;
+                } else
+                    addOpaque(p, &owners[i % 8], (i * 97) % 1700, (i * 53) % 900, 200, 150).rounding = i % 2 ? 8 : 0;
+            }
+        };
+
+        SFramePrep sequential, pooled;
+        FILL(sequential);
+        FILL(pooled);
+
+        prepareFrame(sequential);
+
+        CWorkerPool pool(3);
+        constexpr size_t PERTASK = 8;
+        const auto       TASKS = (pooled.surfaces.size() + PERTASK - 1) / PERTASK;
+        pool.dispatch(TASKS, [&](size_t task) { prepareOpaque(pooled, task * PERTASK, std::min(pooled.surfaces.size(), (task + 1) * PERTASK)); });
+        pool.wait();
+        accumulateOpaque(pooled);
+        pool.dispatch(TASKS, [&](size_t task) { clipDamage(pooled, task * PERTASK, std::min(pooled.surfaces.size(), (task + 1) * PERTASK)); });
+        pool.wait();
+
+        for (size_t i = 0; i < sequential.surfaces.size(); ++i) {
+            EXPECT(pixman_region32_equal(&sequential.surfaces[i].visible, &pooled.surfaces[i].visible), "surface %zu: visible differs on the pool", i);
+            EXPECT(sequential.surfaces[i].pixelsOccluded == pooled.surfaces[i].pixelsOccluded, "surface %zu: occluded px differ on the pool", i);
+        }
+
+        EXPECT(pooled.workNs > 0, "no work counted");
+    }
+
+    return testFailures;
+}
@@ -0,0 +1,138 @@
+#include "shared.hpp"
+#include "headless.hpp"
+#include "../src/debug/HyprCtl.hpp"
+
+#include <cstring>
+
+// reads the binary layout documented in HyprCtl.hpp, fails the test on anything that runs past the end
+struct SReader {
+    const std::string& data;
+    size_t             pos = 0;
+
+    template <typename T>
+    T read() {
+        T value{};
+        EXPECT(pos + sizeof(T) <= data.length(), "read of %zu bytes at %zu past the end (%zu)", sizeof(T), pos, data.length());
+        if (pos + sizeof(T) <= data.length())
+            memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string readString() {
+        const auto LEN = read<uint32_t>();
+        EXPECT(pos + LEN <= data.length(), "string of %u bytes at %zu past the end (%zu)", LEN, pos, data.length());
+        const auto STR = pos + LEN <= data.length() ? data.substr(pos, LEN) : "";
+        pos += LEN;
+        return STR;
+    }
+
+    void header() {
+        EXPECT(data.compare(0, 4, HyprCtl::BINARY_MAGIC) == 0, "no magic");
+        pos = 4;
+        EXPECT(read<uint8_t>() == HyprCtl::BINARY_VERSION, "wrong version");
+    }
+};
+
+int main() {
+    startHeadless();
+
+    const auto PMONITOR = addHeadlessMonitor(Vector2D(0, 0), Vector2D(1920, 1080));
+    addHeadlessMonitor(Vector2D(1920, 0), Vector2D(2560, 1440));
+
+    for (int i = 0; i < 20; ++i) {
+        const auto PWINDOW = addHeadlessWindow(PMONITOR, Vector2D(i * 10, i * 20), Vector2D(300 + i, 200 + i), i % 2);
+        PWINDOW->m_szTitle = "window " + std::to_string(i) + " \"quoted\"";
+    }
+
+    // a window on a workspace that doesn't exist
+    g_pCompositor->m_lWindows.back().m_iWorkspaceID = 42;
+
+    // clients, every field where the layout says
+    {
+        const auto REPLY = HyprCtl::getReply("b/clients");
+        SReader    in{REPLY};
+        in.header();
+
+        const auto COUNT = in.read<uint32_t>();
+        EXPECT(COUNT == 20, "%u clients, expected 20", COUNT);
+
+        auto it = g_pCompositor->m_lWindows.begin();
+        for (uint32_t i = 0; i < COUNT && it != g_pCompositor->m_lWindows.end(); ++i, ++it) {
+            const auto LENGTH = in.read<uint32_t>();
+            const auto START = in.pos;
+
+            EXPECT(in.read<int64_t>() == (int64_t)(uintptr_t)&*it, "client %u: address", i);
+            EXPECT(in.readString() == it->m_szTitle, "client %u: title", i);
+            EXPECT(in.read<int64_t>() == i * 10, "client %u: x", i);
+            EXPECT(in.read<int64_t>() == i * 20, "client %u: y", i);
+            EXPECT(in.read<int64_t>() == 300 + i, "client %u: width", i);
+            EXPECT(in.read<int64_t>() == 200 + i, "client %u: height", i);
+            EXPECT(in.read<int64_t>() == it->m_iWorkspaceID, "client %u: workspace", i);
+            EXPECT(in.readString() == (i == 19 ? "Invalid workspace 42" : "1"), "client %u: workspaceName", i);
+            EXPECT(in.read<uint8_t>() == i % 2, "client %u: floating", i);
+            EXPECT(in.read<int64_t>() == (int64_t)PMONITOR->ID, "client %u: monitor", i);
+            EXPECT(in.readString() == "headless", "client %u: class", i);
+
+            EXPECT(in.pos - START == LENGTH, "client %u: object length %u, fields take %zu", i, LENGTH, in.pos - START);
+        }
+
+        EXPECT(in.pos == REPLY.length(), "%zu bytes left over", REPLY.length() - in.pos);
+    }
+
+    // monitors, read like a version 1 reader would: up to "reserved", the rest skipped by the object's length
+    {
+        const auto REPLY = HyprCtl::getReply("b/monitors");
+        SReader    in{REPLY};
+        in.header();
+
+        const auto COUNT = in.read<uint32_t>();
+        EXPECT(COUNT == 2, "%u monitors, expected 2", COUNT);
+
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            const auto LENGTH = in.read<uint32_t>();
+            const auto START = in.pos;
+
+            EXPECT(in.readString() == "HEADLESS-" + std::to_string(i), "monitor %u: name", i);
+            EXPECT(in.read<int64_t>() == i, "monitor %u: id", i);
+            EXPECT(in.read<int64_t>() == (i == 0 ? 1920 : 2560), "monitor %u: width", i);
+            EXPECT(in.read<int64_t>() == (i == 0 ? 1080 : 1440), "monitor %u: height", i);
+            in.read<double>(); // refreshRate
+            EXPECT(in.read<int64_t>() == (i == 0 ? 0 : 1920), "monitor %u: x", i);
+            EXPECT(in.read<int64_t>() == 0, "monitor %u: y", i);
+            EXPECT(in.read<int64_t>() == i + 1, "monitor %u: activeWorkspace", i);
+            EXPECT(in.readString() == std::to_string(i + 1), "monitor %u: activeWorkspaceName", i);
+            EXPECT(in.read<uint32_t>() == 4, "monitor %u: reserved count", i);
+            for (int j = 0; j < 4; ++j)
+                in.read<int64_t>();
+
+            // and skip the version 2 fields
+            EXPECT(in.pos - START < LENGTH, "monitor %u: nothing past reserved", i);
+            in.pos = START + LENGTH;
+        }
+
+        EXPECT(in.pos == REPLY.length(), "%zu bytes left over after skipping", REPLY.length() - in.pos);
+    }
+
+    // no active window is an empty object
+    {
+        const auto REPLY = HyprCtl::getReply("b/activewindow");
+        SReader    in{REPLY};
+        in.header();
+
+        EXPECT(in.read<uint32_t>() == 0, "activewindow without a window isn't empty");
+        EXPECT(in.pos == REPLY.length(), "%zu bytes left over", REPLY.length() - in.pos);
+    }
+
+    // json escapes the title and has every client
+    {
+        const auto REPLY = HyprCtl::getReply("j/clients");
+        EXPECT(REPLY.front() == '[' && REPLY.back() == ']', "not a json list");
+        EXPECT(REPLY.find("\"title\":\"window 3 \\\"quoted\\\"\"") != std::string::npos, "title not escaped");
+        EXPECT(REPLY.find("\"workspaceName\":\"Invalid workspace 42\"") != std::string::npos, "invalid workspace name missing");
+    }
+
+    stopHeadless();
+
+    return testFailures;
+}
@@ -0,0 +1,139 @@
+#include "shared.hpp"
+#include "../src/render/Scanout.hpp"
+
+// a 1920x1080 monitor at 1920,0 with a lone, opaque fullscreen window exactly covering it
+SScanoutInputs scanoutable() {
+    SScanoutInputs in;
+    in.fullscreenWorkspace = true;
+    in.fullscreenWindowFound = true;
+    in.opaque = true;
+    in.hasBuffer = true;
+    in.surfaces = 1;
+    in.windowPosition = Vector2D(1920, 0);
+    in.windowSize = Vector2D(1920, 1080);
+    in.monitorPosition = Vector2D(1920, 0);
+    in.monitorSize = Vector2D(1920, 1080);
+    in.bufferWidth = in.outputWidth = 1920;
+    in.bufferHeight = in.outputHeight = 1080;
+    return in;
+}
+
+#define EXPECT_FALLBACK(in, expected) \
+    { \
+        const auto RESULT = getScanoutFallback(in); \
+        EXPECT(RESULT == expected, "got %d, expected %d (%s)", RESULT, expected, #expected); \
+    }
+
+int main() {
+    EXPECT_FALLBACK(scanoutable(), SCANOUT_OK);
+
+    // each reason on its own
+    {
+        auto in = scanoutable();
+        in.fullscreenWorkspace = false;
+        EXPECT_FALLBACK(in, SCANOUT_NO_FULLSCREEN);
+    }
+    {
+        auto in = scanoutable();
+        in.fullscreenWindowFound = false;
+        EXPECT_FALLBACK(in, SCANOUT_NO_FULLSCREEN);
+    }
+    {
+        auto in = scanoutable();
+        in.specialWorkspaceOpen = true;
+        EXPECT_FALLBACK(in, SCANOUT_SPECIAL_WORKSPACE);
+    }
+    {
+        auto in = scanoutable();
+        in.windowsAbove = true;
+        EXPECT_FALLBACK(in, SCANOUT_WINDOWS_ABOVE);
+    }
+    {
+        auto in = scanoutable();
+        in.windowsFadingOut = true;
+        EXPECT_FALLBACK(in, SCANOUT_ANIMATING);
+    }
+    {
+        auto in = scanoutable();
+        in.animating = true;
+        EXPECT_FALLBACK(in, SCANOUT_ANIMATING);
+    }
+    for (int i = 0; i < 3; ++i) {
+        auto in = scanoutable();
+        in.overlayLayers = i == 0;
+        in.dragIcon = i == 1;
+        in.debugOverlays = i == 2;
+        EXPECT_FALLBACK(in, SCANOUT_OVERLAYS);
+    }
+    {
+        auto in = scanoutable();
+        in.softwareCursor = true;
+        EXPECT_FALLBACK(in, SCANOUT_SOFTWARE_CURSOR);
+    }
+    {
+        auto in = scanoutable();
+        in.opaque = false;
+        EXPECT_FALLBACK(in, SCANOUT_NOT_OPAQUE);
+    }
+    {
+        auto in = scanoutable();
+        in.hasBuffer = false;
+        EXPECT_FALLBACK(in, SCANOUT_NO_BUFFER);
+    }
+    {
+        auto in = scanoutable();
+        in.surfaces = 2;
+        EXPECT_FALLBACK(in, SCANOUT_SUBSURFACES);
+    }
+
+    // geometry: anything that would need the buffer scaled, moved, cropped or rotated
+    {
+        auto in = scanoutable();
+        in.windowPosition = Vector2D(0, 0);
+        EXPECT_FALLBACK(in, SCANOUT_GEOMETRY);
+    }
+    {
+        auto in = scanoutable();
+        in.windowSize = Vector2D(1920, 1050);
+        EXPECT_FALLBACK(in, SCANOUT_GEOMETRY);
+    }
+    {
+        auto in = scanoutable();
+        in.bufferWidth = 3840;
+        in.bufferHeight = 2160;
+        EXPECT_FALLBACK(in, SCANOUT_GEOMETRY);
+    }
+    {
+        auto in = scanoutable();
+        in.bufferTransform = 1;
+        EXPECT_FALLBACK(in, SCANOUT_GEOMETRY);
+    }
+    {
+        auto in = scanoutable();
+        in.bufferCropped = true;
+        EXPECT_FALLBACK(in, SCANOUT_GEOMETRY);
+    }
+
+    // several at once: the cheap, workspace-wide reasons win
+    {
+        auto in = scanoutable();
+        in.specialWorkspaceOpen = true;
+        in.softwareCursor = true;
+        in.opaque = false;
+        EXPECT_FALLBACK(in, SCANOUT_SPECIAL_WORKSPACE);
+    }
+    {
+        auto in = scanoutable();
+        in.overlayLayers = true;
+        in.surfaces = 3;
+        EXPECT_FALLBACK(in, SCANOUT_OVERLAYS);
+    }
+
+    // no fullscreen workspace, the rest is never gathered and must not matter
+    {
+        SScanoutInputs in;
+        EXPECT_FALLBACK(in, SCANOUT_NO_FULLSCREEN);
+    }
+
+    return testFailures;
+}
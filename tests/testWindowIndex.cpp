@@ -0,0 +1,85 @@
+#include "shared.hpp"
+#include "headless.hpp"
+
+constexpr int WINDOWS = 5000;
+
+int main() {
+    startHeadless();
+
+    const auto PMONITOR = addHeadlessMonitor(Vector2D(0, 0), Vector2D(1920, 1080));
+
+    std::vector<CWindow*> windows;
+    for (int i = 0; i < WINDOWS; ++i) {
+        windows.push_back(addHeadlessWindow(PMONITOR, Vector2D((i * 37) % 1600, (i * 23) % 900), Vector2D(320, 180), i % 4 == 0));
+        windows.back()->m_iWorkspaceID = i % 10 + 1;
+    }
+
+    // every window by its surface
+    for (const auto& w : windows) {
+        const auto PSURFACE = g_pXWaylandManager->getWindowSurface(w);
+        EXPECT(g_pCompositor->getWindowFromSurface(PSURFACE) == w, "window %p not found by its surface", w);
+    }
+
+    // surfaces of layers, popups and subsurfaces, which no window has
+    std::list<wlr_surface> others(1000);
+    for (auto& s : others)
+        EXPECT(g_pCompositor->getWindowFromSurface(&s) == nullptr, "%p isn't a window's surface", &s);
+
+    EXPECT(g_pCompositor->getWindowFromSurface(nullptr) == nullptr, "nullptr isn't a window's surface");
+
+    // every workspace bucket holds its windows, in stacking order
+    for (int id = 1; id <= 10; ++id) {
+        const auto& BUCKET = g_pCompositor->getIndexedWindowsOnWorkspace(id);
+        EXPECT(BUCKET.size() == WINDOWS / 10, "workspace %d has %zu windows, expected %d", id, BUCKET.size(), WINDOWS / 10);
+
+        for (size_t i = 0; i < BUCKET.size(); ++i)
+            EXPECT(BUCKET[i] == windows[i * 10 + id - 1], "workspace %d, window %zu out of order", id, i);
+    }
+
+    // remove every other window, their surfaces are gone with them
+    std::vector<wlr_surface*> removedSurfaces;
+    for (size_t i = 0; i < windows.size(); i += 2) {
+        removedSurfaces.push_back(g_pXWaylandManager->getWindowSurface(windows[i]));
+        g_pCompositor->removeWindowFromVectorSafe(windows[i]);
+    }
+
+    for (const auto& s : removedSurfaces)
+        EXPECT(g_pCompositor->getWindowFromSurface(s) == nullptr, "removed window's surface %p still found", s);
+
+    for (size_t i = 1; i < windows.size(); i += 2) {
+        const auto PSURFACE = g_pXWaylandManager->getWindowSurface(windows[i]);
+        EXPECT(g_pCompositor->getWindowFromSurface(PSURFACE) == windows[i], "window %p lost after removing others", windows[i]);
+    }
+
+    // the hit-tests agree with a walk over every window: topmost floating window, then tiled ones on the shown workspace
+    for (int y = 0; y < 1080; y += 45) {
+        for (int x = 0; x < 1920; x += 45) {
+            CWindow* expected = nullptr;
+
+            for (auto w = g_pCompositor->m_lWindows.rbegin(); w != g_pCompositor->m_lWindows.rend(); ++w) {
+                wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+                if (w->m_bIsFloating && w->m_iWorkspaceID == PMONITOR->activeWorkspace && wlr_box_contains_point(&box, x, y)) {
+                    expected = &*w;
+                    break;
+                }
+            }
+
+            if (!expected) {
+                for (auto& w : g_pCompositor->m_lWindows) {
+                    wlr_box box = {w.m_vRealPosition.vec().x, w.m_vRealPosition.vec().y, w.m_vRealSize.vec().x, w.m_vRealSize.vec().y};
+                    if (!w.m_bIsFloating && w.m_iWorkspaceID == PMONITOR->activeWorkspace && wlr_box_contains_point(&box, x, y)) {
+                        expected = &w;
+                        break;
+                    }
+                }
+            }
+
+            const auto FOUND = g_pCompositor->vectorToWindow(Vector2D(x, y));
+            EXPECT(FOUND == expected, "at %d,%d got %p, expected %p", x, y, FOUND, expected);
+        }
+    }
+
+    stopHeadless();
+
+    return testFailures;
+}